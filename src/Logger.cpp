@@ -7,32 +7,99 @@
  * @brief   Simple logging module
  */
 
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <pthread.h>
+
 #include "Logger.h"
 
 namespace
 {
-    using namespace whm::Color;
-    using whm::Color::Modifier;
-
-    Modifier r(FG_RED);
-    Modifier b(FG_BLUE);
-    Modifier c(FG_CYAN);
-    Modifier g(FG_GREEN);
-    Modifier y(FG_YELLOW);
-    Modifier d(FG_DEFAULT);
+    constexpr const char* blue    = "\033[34m";
+    constexpr const char* cyan    = "\033[36m";
+    constexpr const char* normal  = "\033[39m";
+
+    const char* plainLvlStr(whm::LogLevel_t level)
+    {
+        switch(level)
+        {
+            case whm::LogLevel_t::E_DEBUG:   return "INFO";
+            case whm::LogLevel_t::E_WARNING: return "WARNING";
+            case whm::LogLevel_t::E_ERROR:   return "ERROR";
+        }
+
+        return "";
+    }
+
+    void appendJson(std::string& out, const char* value)
+    {
+        out.push_back('"');
+
+        for(const char* c = value; *c; ++c)
+        {
+            switch(*c)
+            {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n";  break;
+                case '\r': out += "\\r";  break;
+                case '\t': out += "\\t";  break;
+                default:
+                {
+                    if(static_cast<unsigned char>(*c) < 0x20)
+                    {
+                        char escaped[8];
+                        snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                        out += escaped;
+                    }
+                    else
+                    {
+                        out.push_back(*c);
+                    }
+                }
+            }
+        }
+
+        out.push_back('"');
+    }
 }
 
 namespace whm
 {
     Logger_t::Logger_t()
         : os{ &std::cout }
+        , ring{ new Record_t[E_QUEUE_SIZE] }
     {
+        for(size_t i = 0; i < E_QUEUE_SIZE; ++i)
+        {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
 
+        static std::once_flag atfork;
+
+        std::call_once(atfork, []()
+                               {
+                                   pthread_atfork(&Logger_t::prepareFork, &Logger_t::parentFork, &Logger_t::childFork);
+                               });
     }
 
     Logger_t::~Logger_t()
     {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+
+        // Forked child must not signal, the condition still counts the parent's flusher as a waiter
+        if(flusher)
+        {
+            wakeup.notify_one();
+            flusher->join();
+            delete flusher;
+        }
 
+        flush();
     }
 
     Logger_t& Logger_t::getLogger()
@@ -43,6 +110,9 @@ namespace whm
 
     void Logger_t::setStream(std::ostream& os_)
     {
+        flush();
+
+        std::lock_guard<std::mutex> lock(mutex);
         os = &os_;
     }
 
@@ -51,30 +121,249 @@ namespace whm
         verbose = verbose_;
     }
 
-    bool Logger_t::isVerbose() const
+    void Logger_t::setLevel(LogLevel_t level)
+    {
+        minLevel.store(level, std::memory_order_relaxed);
+    }
+
+    void Logger_t::setFormat(LogFormat_t logFormat_)
     {
-        return verbose;
+        flush();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        logFormat = logFormat_;
     }
 
-    void Logger_t::print(const char* file,
-                         const char* func,
-                         uint32_t    line,
-                         LogLevel_t  level,
-                         const char* format,
-                         ...)
+    void Logger_t::log(const char* file,
+                       const char* func,
+                       uint32_t    line,
+                       LogLevel_t  level,
+                       const char* format,
+                       ...)
     {
         va_list args;
 
-        va_start(args, format);
+        if(!async.load(std::memory_order_acquire))
+        {
+            start();
+        }
+
+        // Forked child has no flusher thread, message is written right away
+        if(!async.load(std::memory_order_acquire))
+        {
+            Record_t record;
+
+            record.level = level;
+            record.line = line;
+            record.file = file;
+            record.func = func;
+            record.time = std::time(nullptr);
+
+            va_start(args, format);
+            vsnprintf(record.message, E_MESSAGE_SIZE, format, args);
+            va_end(args);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            write(record);
+            os->flush();
+            return;
+        }
 
-        char buffer[1024];
-        vsnprintf(buffer, 1024, format, args);
+        // Claim a slot, when the ring is full wait for the flusher
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Record_t* record;
 
-        static auto ts = std::put_time(std::localtime(&time_now), "%y-%m-%d %OH:%OM:%OS");
+        for(;;)
+        {
+            record = &ring[pos & (E_QUEUE_SIZE - 1)];
 
-        *os << b << "<" << ts << ">" << lvlStr(level) << c << file << " (" << func << "():" << line << ") >> " << d << buffer << std::endl;
+            size_t sequence = record->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
 
+            if(diff == 0)
+            {
+                if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if(diff < 0)
+            {
+                wakeup.notify_one();
+                std::this_thread::yield();
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->level = level;
+        record->line = line;
+        record->file = file;
+        record->func = func;
+        record->time = std::time(nullptr);
+
+        va_start(args, format);
+        vsnprintf(record->message, E_MESSAGE_SIZE, format, args);
         va_end(args);
+
+        record->sequence.store(pos + 1, std::memory_order_seq_cst);
+
+        if(level == LogLevel_t::E_ERROR)
+        {
+            flush();
+        }
+        else if(sleeping.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            wakeup.notify_one();
+        }
+    }
+
+    void Logger_t::printRaw(const std::string& text)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        drain();
+        *os << text;
+
+        if(!async.load(std::memory_order_relaxed))
+        {
+            os->flush();
+        }
+    }
+
+    void Logger_t::flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        drain();
+        os->flush();
+    }
+
+    void Logger_t::start()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(!flusher && !running)
+        {
+            running = true;
+            flusher = new std::thread(&Logger_t::run, this);
+            async.store(true, std::memory_order_release);
+        }
+    }
+
+    void Logger_t::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while(running)
+        {
+            drain();
+            os->flush();
+
+            // Producer checks the flag after publishing, so it either sees it or its message is pending here
+            sleeping.store(true, std::memory_order_seq_cst);
+
+            if(running && !pending())
+            {
+                wakeup.wait_for(lock, std::chrono::milliseconds(100));
+            }
+
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+
+        drain();
+        os->flush();
+    }
+
+    bool Logger_t::pending() const
+    {
+        return ring[dequeuePos & (E_QUEUE_SIZE - 1)].sequence.load(std::memory_order_seq_cst) == dequeuePos + 1;
+    }
+
+    void Logger_t::drain()
+    {
+        while(pending())
+        {
+            auto& record = ring[dequeuePos & (E_QUEUE_SIZE - 1)];
+
+            write(record);
+
+            record.sequence.store(dequeuePos + E_QUEUE_SIZE, std::memory_order_release);
+            ++dequeuePos;
+        }
+    }
+
+    void Logger_t::write(const Record_t& record)
+    {
+        char ts[32];
+        struct tm local{};
+
+        localtime_r(&record.time, &local);
+        strftime(ts, sizeof(ts), logFormat == LogFormat_t::E_JSON ? "%Y-%m-%dT%H:%M:%S" : "%y-%m-%d %H:%M:%S", &local);
+
+        output.clear();
+
+        switch(logFormat)
+        {
+            case LogFormat_t::E_COLOR:
+            {
+                output.append(blue).append("<").append(ts).append(">").append(lvlStr(record.level))
+                    .append(cyan).append(record.file).append(" (").append(record.func).append("():")
+                    .append(std::to_string(record.line)).append(") >> ").append(normal).append(record.message);
+                break;
+            }
+            case LogFormat_t::E_PLAIN:
+            {
+                output.append("<").append(ts).append("> [").append(plainLvlStr(record.level)).append("] ")
+                    .append(record.file).append(" (").append(record.func).append("():")
+                    .append(std::to_string(record.line)).append(") >> ").append(record.message);
+                break;
+            }
+            case LogFormat_t::E_JSON:
+            {
+                output.append("{\"time\":\"").append(ts).append("\",\"level\":\"").append(plainLvlStr(record.level)).append("\",\"file\":");
+                appendJson(output, record.file);
+                output.append(",\"function\":");
+                appendJson(output, record.func);
+                output.append(",\"line\":").append(std::to_string(record.line)).append(",\"message\":");
+                appendJson(output, record.message);
+                output.append("}");
+                break;
+            }
+        }
+
+        output.push_back('\n');
+        os->write(output.data(), output.size());
+    }
+
+    void Logger_t::prepareFork()
+    {
+        auto& logger = getLogger();
+
+        // Nothing may be half written nor left in the ring for the child to print again
+        logger.mutex.lock();
+        logger.drain();
+        logger.os->flush();
+    }
+
+    void Logger_t::parentFork()
+    {
+        getLogger().mutex.unlock();
+    }
+
+    void Logger_t::childFork()
+    {
+        auto& logger = getLogger();
+
+        // Thread does not exist in the child, its handle must not be joined nor destroyed
+        logger.flusher = nullptr;
+        logger.running = true;
+        logger.async.store(false, std::memory_order_release);
+        logger.mutex.unlock();
     }
 
     const char* Logger_t::lvlStr(const LogLevel_t& level)
@@ -98,3 +387,9 @@ namespace whm
         return "";
     }
 }
+
+namespace
+{
+    // Logger exists before the first fork, so its fork handlers are always in place
+    [[maybe_unused]] const whm::Logger_t& logger = whm::Logger_t::getLogger();
+}
@@ -10,14 +10,23 @@
 #pragma once
 
 #include <ctime>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
 #include <iomanip>
 #include <fstream>
 #include <iostream>
 #include <stdarg.h>
+#include <condition_variable>
 
 #define LOG_LOC __FILE__, &__FUNCTION__[ 0 ], __LINE__
 
-static std::time_t time_now = std::time(nullptr);
+/// Messages below this level are removed at compile time (0: debug, 1: warning, 2: error)
+#ifndef WHM_LOG_LEVEL
+#   define WHM_LOG_LEVEL 0
+#endif
 
 namespace whm
 {
@@ -28,30 +37,111 @@ namespace whm
         E_ERROR
     };
 
+    enum class LogFormat_t
+    {
+        E_COLOR,
+        E_PLAIN,
+        E_JSON
+    };
+
+    /**
+     * @brief Asynchronous logger
+     *
+     * Messages are formatted by the calling thread into a bounded lock-free ring
+     * (multiple producers, single consumer) and written by a background thread,
+     * so printing does not wait for the output stream. Errors, oversized output
+     * and forked children are written synchronously.
+     */
     class Logger_t
     {
         public:
+            static constexpr LogLevel_t E_MIN_LEVEL = static_cast<LogLevel_t>(WHM_LOG_LEVEL);
+            static constexpr size_t E_QUEUE_SIZE = 1 << 8;
+            static constexpr size_t E_MESSAGE_SIZE = 1024;
+
             Logger_t();
             ~Logger_t();
 
             static Logger_t& getLogger();
 
             void setVerbose(bool);
-            bool isVerbose() const;
+            bool isVerbose() const
+            {
+                return E_MIN_LEVEL == LogLevel_t::E_DEBUG && verbose;
+            }
 
+            void setLevel(LogLevel_t);
+            bool isEnabled(LogLevel_t level) const
+            {
+                return level >= E_MIN_LEVEL && level >= minLevel.load(std::memory_order_relaxed);
+            }
+
+            void setFormat(LogFormat_t);
             void setStream(std::ostream&);
 
             const char* lvlStr(const LogLevel_t&);
 
-            void print(const char*,
-                       const char*,
-                       uint32_t,
-                       LogLevel_t,
-                       const char*, ...);
+            template <typename... Args>
+            void print(const char* file,
+                       const char* func,
+                       uint32_t    line,
+                       LogLevel_t  level,
+                       const char* format,
+                       Args...     args)
+            {
+                if(isEnabled(level))
+                {
+                    log(file, func, line, level, format, args...);
+                }
+            }
+
+            /// Writes text as is, in order with queued messages
+            void printRaw(const std::string&);
+
+            /// Waits until all queued messages are written
+            void flush();
+
+        protected:
+            struct Record_t
+            {
+                std::atomic<size_t> sequence;
+                LogLevel_t level;
+                uint32_t line;
+                const char* file;
+                const char* func;
+                std::time_t time;
+                char message[E_MESSAGE_SIZE];
+            };
+
+            void log(const char*, const char*, uint32_t, LogLevel_t, const char*, ...);
+
+            void start();
+            void run();
+            bool pending() const;
+            void drain();
+            void write(const Record_t&);
+
+            static void prepareFork();
+            static void parentFork();
+            static void childFork();
 
         private:
             bool verbose{ false };
+            std::atomic<LogLevel_t> minLevel{ LogLevel_t::E_DEBUG };
+            LogFormat_t logFormat{ LogFormat_t::E_COLOR };
             std::ostream* os{ nullptr };
+
+            std::unique_ptr<Record_t[]> ring;
+            alignas(64) std::atomic<size_t> enqueuePos{ 0 };
+            alignas(64) size_t dequeuePos{ 0 };  //< Guarded by mutex
+
+            std::mutex mutex;                    //< Held by the one who writes to the stream
+            std::condition_variable wakeup;
+            std::atomic<bool> sleeping{ false };
+            std::atomic<bool> async{ false };
+            bool running{ false };
+            std::thread* flusher{ nullptr };
+            std::string output;                  //< Line being written by the writer
     };
 
     ///
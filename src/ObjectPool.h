@@ -0,0 +1,162 @@
+/**
+ * Warehouse manager
+ *
+ * @file    ObjectPool.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Fixed-size block pool used to recycle short-lived objects between simulation runs
+ */
+
+#pragma once
+
+// Std
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+namespace whm
+{
+    /**
+     * @brief Pool of raw blocks, each able to hold one object of type T
+     *
+     * Blocks are carved out of chunks which are never returned to the global allocator
+     * until the pool itself is destroyed. Once the pool has grown to the peak number of
+     * objects alive at the same time, allocations are served purely from the free list.
+     */
+    template<typename T>
+    class ObjectPool_t
+    {
+        public:
+            explicit ObjectPool_t(size_t blocksPerChunk_ = 256)
+                : blocksPerChunk{ blocksPerChunk_ }
+            {
+
+            }
+
+            ~ObjectPool_t()
+            {
+                reset();
+            }
+
+            ObjectPool_t(const ObjectPool_t&) = delete;
+            ObjectPool_t& operator=(const ObjectPool_t&) = delete;
+
+            /**
+             * @brief Returns uninitialized storage for one object of type T
+             */
+            void* allocate()
+            {
+                if(freeBlocks.empty())
+                {
+                    grow();
+                }
+
+                Block_t* block = freeBlocks.back();
+                freeBlocks.pop_back();
+
+                block->alive = true;
+                ++ usedBlocks;
+
+                return block->storage;
+            }
+
+            /**
+             * @brief Returns storage previously obtained by allocate() back to the pool
+             *
+             * @note Object has to be already destroyed at this point
+             */
+            void deallocate(void* p)
+            {
+                Block_t* block = reinterpret_cast<Block_t*>(p);
+
+                if(block->alive)
+                {
+                    block->alive = false;
+                    -- usedBlocks;
+
+                    freeBlocks.push_back(block);
+                }
+            }
+
+            /**
+             * @brief Destroys all objects which are still alive and makes every block available again
+             */
+            void reset()
+            {
+                for(auto& chunk : chunks)
+                {
+                    for(size_t i = 0; i < blocksPerChunk; ++i)
+                    {
+                        Block_t& block = chunk[i];
+
+                        if(block.alive)
+                        {
+                            block.alive = false;
+                            reinterpret_cast<T*>(block.storage)->~T();
+                        }
+                    }
+                }
+
+                freeBlocks.clear();
+
+                for(auto& chunk : chunks)
+                {
+                    for(size_t i = 0; i < blocksPerChunk; ++i)
+                    {
+                        freeBlocks.push_back(&chunk[i]);
+                    }
+                }
+
+                usedBlocks = 0;
+            }
+
+            /**
+             * @brief Returns true, if storage belongs to one of the pool chunks
+             */
+            bool owns(const void* p) const
+            {
+                std::less<const void*> less;
+
+                for(const auto& chunk : chunks)
+                {
+                    const Block_t* first = chunk.get();
+
+                    if(!less(p, first) && less(p, first + blocksPerChunk))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            size_t used() const     { return usedBlocks; }
+            size_t capacity() const { return chunks.size() * blocksPerChunk; }
+
+        private:
+            struct Block_t
+            {
+                alignas(T) unsigned char storage[sizeof(T)]; //< Must stay first, block is addressed by its storage
+                bool alive{ false };
+            };
+
+            void grow()
+            {
+                chunks.emplace_back(new Block_t[blocksPerChunk]);
+
+                auto& chunk = chunks.back();
+
+                for(size_t i = blocksPerChunk; i > 0; --i)
+                {
+                    freeBlocks.push_back(&chunk[i - 1]);
+                }
+            }
+
+            size_t usedBlocks{ 0 };
+            size_t blocksPerChunk{ 0 };
+
+            std::vector<Block_t*> freeBlocks;
+            std::vector<std::unique_ptr<Block_t[]>> chunks;
+    };
+}
@@ -19,21 +19,50 @@ namespace whm
             std::cout << "\nUsage:\n\n"
                          "\t-h\tPrints this usage\n"
                          "\t-v\tTriggers verbose mode\n"
-                         "\t-o\tPath to a file with customer orders\n"
+                         "\t-o\tPath to a file with customer orders (XML or binary)\n"
                          "\t-a\tPath to a file with articles\n"
                          "\t-i\tPath to a file with article-slot allocation\n"
                          "\t-l\tPath to a file with warehouse layout description\n"
                          "\t-s\tShow aggregated statistics for path finder\n"
+                         "\t-L\tLowest printed log level: [ debug | warning | error ]\n"
+                         "\t-f\tLog output format: [ color | plain | json ]\n"
+                         "\t-c\tConvert customer orders given by -o to binary format and exit\n"
                          "\t-O\tOptimizer to be used: [ 1: GA | 2: DE | 3: ABC | 4:PSO | 5:SLAP | 6:RAND ]\n"
                         ;
         }
 
+        LogLevel_t parseLogLevel(const std::string& level)
+        {
+            std::string lvl = toLower(level);
+
+            if(lvl == "debug")   return LogLevel_t::E_DEBUG;
+            if(lvl == "warning") return LogLevel_t::E_WARNING;
+            if(lvl == "error")   return LogLevel_t::E_ERROR;
+
+            std::cerr << "Invalid log level <" << level << ">!" << std::endl;
+            printHelp();
+            exit(1);
+        }
+
+        LogFormat_t parseLogFormat(const std::string& format)
+        {
+            std::string fmt = toLower(format);
+
+            if(fmt == "color") return LogFormat_t::E_COLOR;
+            if(fmt == "plain") return LogFormat_t::E_PLAIN;
+            if(fmt == "json")  return LogFormat_t::E_JSON;
+
+            std::cerr << "Invalid log format <" << format << ">!" << std::endl;
+            printHelp();
+            exit(1);
+        }
+
         WhmArgs_t parseArgs(int argc, char *argv[])
         {
             int c;
             WhmArgs_t args;
 
-            while ((c = getopt (argc, argv, "o:a:i:l:O:sv")) != -1)
+            while ((c = getopt (argc, argv, "o:a:i:l:c:O:L:f:sv")) != -1)
             {
                 switch(c)
                 {
@@ -49,6 +78,9 @@ namespace whm
                     case 'l':
                         args.layoutPath = optarg;
                         break;
+                    case 'c':
+                        args.convertPath = optarg;
+                        break;
                     case 's':
                         args.stats = true;
                         break;
@@ -58,6 +90,12 @@ namespace whm
                     case 'v':
                         whm::Logger_t::getLogger().setVerbose(true);
                         break;
+                    case 'L':
+                        whm::Logger_t::getLogger().setLevel(parseLogLevel(optarg));
+                        break;
+                    case 'f':
+                        whm::Logger_t::getLogger().setFormat(parseLogFormat(optarg));
+                        break;
                     case 'h':
                         printHelp();
                         exit(0);
@@ -21,6 +21,9 @@
 #include <algorithm>
 #include <unordered_set>
 
+// Local
+#include "Logger.h"
+
 namespace whm
 {
     namespace utils
@@ -38,6 +41,7 @@ namespace whm
             std::string articlesPath;    //< Path to a file with articles
             std::string locationsPath;   //< Path to a file with article-slot allocation
             std::string layoutPath;      //< Path to a file with warehouse layout description
+            std::string convertPath;     //< Path where customer orders are written in binary format
         };
 
         /**
@@ -54,6 +58,12 @@ namespace whm
          */
         void printHelp();
 
+        /**
+         * @brief Converts log level/format given on command line, exits on invalid value
+         */
+        LogLevel_t parseLogLevel(const std::string&);
+        LogFormat_t parseLogFormat(const std::string&);
+
         /**
          * @brief Prints contents of vector
          */
@@ -0,0 +1,81 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseArticles.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Dictionary mapping article names to dense numeric IDs
+ */
+
+#include "WarehouseArticles.h"
+
+namespace whm
+{
+    WarehouseArticles_t::WarehouseArticles_t()
+    {
+
+    }
+
+    WarehouseArticles_t::~WarehouseArticles_t()
+    {
+
+    }
+
+    WarehouseArticles_t& WarehouseArticles_t::getWhArticles()
+    {
+        static WarehouseArticles_t a;
+        return a;
+    }
+
+    int32_t WarehouseArticles_t::intern(const std::string& article)
+    {
+        if(article.empty())
+        {
+            return E_NO_ARTICLE;
+        }
+
+        auto it = articleIDs.find(article);
+
+        if(it != articleIDs.end())
+        {
+            return it->second;
+        }
+
+        int32_t articleID = static_cast<int32_t>(articles.size());
+
+        articles.push_back(article);
+        articleIDs.emplace(article, articleID);
+
+        return articleID;
+    }
+
+    int32_t WarehouseArticles_t::lookup(const std::string& article) const
+    {
+        auto it = articleIDs.find(article);
+
+        return it != articleIDs.end() ? it->second : E_NO_ARTICLE;
+    }
+
+    const std::string& WarehouseArticles_t::getArticle(int32_t articleID) const
+    {
+        static const std::string noArticle;
+
+        return articleID == E_NO_ARTICLE ? noArticle : articles.at(articleID);
+    }
+
+    const std::vector<std::string>& WarehouseArticles_t::getArticles() const
+    {
+        return articles;
+    }
+
+    size_t WarehouseArticles_t::size() const
+    {
+        return articles.size();
+    }
+
+    void WarehouseArticles_t::clear()
+    {
+        articles.clear();
+        articleIDs.clear();
+    }
+}
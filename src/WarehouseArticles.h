@@ -0,0 +1,46 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseArticles.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Dictionary mapping article names to dense numeric IDs
+ */
+
+#pragma once
+
+// Std
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace whm
+{
+    /**
+     * @brief Every article name is stored once, slots and orders refer to it by its ID
+     */
+    class WarehouseArticles_t
+    {
+        public:
+            static constexpr int32_t E_NO_ARTICLE = -1;
+
+            WarehouseArticles_t();
+            ~WarehouseArticles_t();
+
+            static WarehouseArticles_t& getWhArticles();
+
+            int32_t intern(const std::string&);
+            int32_t lookup(const std::string&) const;
+
+            const std::string& getArticle(int32_t) const;
+            const std::vector<std::string>& getArticles() const;
+
+            size_t size() const;
+            void clear();
+
+        private:
+            std::vector<std::string> articles;
+            std::unordered_map<std::string, int32_t> articleIDs;
+    };
+}
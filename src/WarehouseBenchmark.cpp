@@ -0,0 +1,256 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseBenchmark.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Benchmarks of data import (time and peak memory of each loader)
+ */
+
+#ifdef WHM_BENCH
+
+// Std
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+// Unix
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+// Local
+#include "Logger.h"
+#include "WarehouseLayout.h"
+#include "WarehouseArticles.h"
+#include "WarehouseBenchmark.h"
+
+#include "tinyxml2.h"
+
+namespace whm
+{
+    namespace
+    {
+        struct MeasureResult_t
+        {
+            double bestTime;
+            double meanTime;
+            uint64_t checksum;
+            size_t orderCount;
+            size_t lineCount;
+        };
+
+        /// Loader used before streaming import, whole document is held in memory
+        void importCustomerOrdersDom(const std::string& xmlFilename, WarehouseOrderBook_t& whOrders)
+        {
+            tinyxml2::XMLDocument* doc = new tinyxml2::XMLDocument();
+
+            if(doc->LoadFile(xmlFilename.c_str()) != tinyxml2::XML_SUCCESS)
+            {
+                delete doc;
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+
+            auto& whArticles = WarehouseArticles_t::getWhArticles();
+
+            for (tinyxml2::XMLElement* whOrderXml = doc->FirstChildElement("WarehouseOrder"); whOrderXml; whOrderXml = whOrderXml->NextSiblingElement("WarehouseOrder"))
+            {
+                whOrders.addWhOrder(whOrderXml->IntAttribute("id"), static_cast<WarehouseOrderType_t>(whOrderXml->IntAttribute("type")));
+
+                for (tinyxml2::XMLElement* whLineXml = whOrderXml->FirstChildElement("WarehouseOrderLine"); whLineXml; whLineXml = whLineXml->NextSiblingElement("WarehouseOrderLine"))
+                {
+                    whOrders.addWhOrderLine(whLineXml->IntAttribute("id"),
+                                            whArticles.intern(whLineXml->Attribute("article_name")),
+                                            whLineXml->IntAttribute("requested_quantity"));
+                }
+            }
+
+            delete doc;
+        }
+
+        void fnv(uint64_t& hash, const void* data, size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+
+            for(size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ULL;
+            }
+        }
+    }
+
+    WarehouseBenchmark_t::WarehouseBenchmark_t(const utils::WhmArgs_t& args_)
+        : cfg{ ConfigParser_t{ "cfg/benchmark.xml" } }
+        , args{ args_ }
+    {
+
+    }
+
+    WarehouseBenchmark_t::WarehouseBenchmark_t(const utils::WhmArgs_t& args_, const ConfigParser_t& cfg_)
+        : cfg{ cfg_ }
+        , args{ args_ }
+    {
+
+    }
+
+    WarehouseBenchmark_t::~WarehouseBenchmark_t()
+    {
+
+    }
+
+    void WarehouseBenchmark_t::run()
+    {
+        if(!args.ordersPath.empty())
+        {
+            benchmarkOrderImport();
+        }
+    }
+
+    void WarehouseBenchmark_t::benchmarkOrderImport()
+    {
+        auto& layout = WarehouseLayout_t::getWhLayout();
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "[BENCH] Order import of <%s>", args.ordersPath.c_str());
+
+        measure("tinyxml2 DOM", [&]()
+                                {
+                                    importCustomerOrdersDom(args.ordersPath, const_cast<WarehouseOrderBook_t&>(layout.getWhOrders()));
+                                });
+
+        measure("streaming", [&]()
+                             {
+                                 layout.importCustomerOrders(args.ordersPath);
+                             });
+
+        size_t threadCount = std::max(1, cfg.getAs<int32_t>("threads"));
+
+        measure("parallel x" + std::to_string(threadCount), [&]()
+                                                             {
+                                                                 layout.importCustomerOrdersParallel(args.ordersPath, threadCount);
+                                                             });
+
+        // Binary file is produced by a child process, so this one stays small for the next measurement
+        char binPath[] = "/tmp/whm_orders_XXXXXX";
+        int fd = mkstemp(binPath);
+
+        if(fd < 0)
+        {
+            throw std::runtime_error("Failed to create temporary orders binary!");
+        }
+
+        close(fd);
+
+        pid_t pid = fork();
+
+        if(pid == 0)
+        {
+            layout.importCustomerOrders(args.ordersPath);
+            layout.exportCustomerOrdersBinary(binPath);
+            _exit(0);
+        }
+
+        waitpid(pid, nullptr, 0);
+
+        measure("binary mmap", [&]()
+                               {
+                                   layout.importCustomerOrders(binPath);
+                               });
+
+        unlink(binPath);
+    }
+
+    void WarehouseBenchmark_t::measure(const std::string& name, Loader_t loader)
+    {
+        int fd[2];
+
+        if(pipe(fd))
+        {
+            throw std::runtime_error("Failed to create benchmark pipe!");
+        }
+
+        pid_t pid = fork();
+
+        if(pid < 0)
+        {
+            throw std::runtime_error("Failed to fork benchmark process!");
+        }
+
+        if(pid == 0)
+        {
+            close(fd[0]);
+
+            MeasureResult_t result{ std::numeric_limits<double>::max(), 0., 0, 0, 0 };
+            int32_t repetitions = std::max(1, cfg.getAs<int32_t>("repetitions"));
+
+            for(int32_t i = 0; i < repetitions; ++i)
+            {
+                WarehouseLayout_t::getWhLayout().clearWhOrders();
+                WarehouseArticles_t::getWhArticles().clear();
+
+                auto start = std::chrono::steady_clock::now();
+                loader();
+                std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+                result.bestTime = std::min(result.bestTime, elapsed.count());
+                result.meanTime += elapsed.count() / repetitions;
+            }
+
+            const auto& whOrders = WarehouseLayout_t::getWhLayout().getWhOrders();
+
+            result.checksum = ordersChecksum();
+            result.orderCount = whOrders.size();
+            result.lineCount = whOrders.getLineCount();
+
+            ssize_t written = write(fd[1], &result, sizeof(result));
+            close(fd[1]);
+
+            _exit(written == sizeof(result) ? 0 : 1);
+        }
+
+        close(fd[1]);
+
+        MeasureResult_t result{};
+        ssize_t received = read(fd[0], &result, sizeof(result));
+        close(fd[0]);
+
+        int status{ 0 };
+        struct rusage usage{};
+
+        wait4(pid, &status, 0, &usage);
+
+        if(received != sizeof(result) || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "[BENCH] Loader <%s> failed", name.c_str());
+            return;
+        }
+
+        // ru_maxrss is in kilobytes on Linux
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG,
+                                    "[BENCH] %-14s orders <%zu> lines <%zu> best <%.2f ms> mean <%.2f ms> peak RSS <%.1f MB> checksum <%016llx>",
+                                    name.c_str(), result.orderCount, result.lineCount, result.bestTime, result.meanTime,
+                                    usage.ru_maxrss / 1024., static_cast<unsigned long long>(result.checksum));
+    }
+
+    uint64_t WarehouseBenchmark_t::ordersChecksum() const
+    {
+        uint64_t hash{ 14695981039346656037ULL };
+
+        for(const auto& whOrder : WarehouseLayout_t::getWhLayout().getWhOrders())
+        {
+            int32_t header[2] = { whOrder.getWhOrderID(), to_underlying(whOrder.getWhOrderType()) };
+            fnv(hash, header, sizeof(header));
+
+            for(const auto& whLine : whOrder)
+            {
+                int32_t line[2] = { whLine.getWhLineID(), whLine.getQuantity() };
+                fnv(hash, line, sizeof(line));
+                fnv(hash, whLine.getArticle().data(), whLine.getArticle().size());
+            }
+        }
+
+        return hash;
+    }
+}
+
+#endif
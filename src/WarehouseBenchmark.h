@@ -0,0 +1,51 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseBenchmark.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Benchmarks of data import (time and peak memory of each loader)
+ */
+
+#pragma once
+
+#ifdef WHM_BENCH
+
+// Local
+#include "Utils.h"
+#include "ConfigParser.h"
+
+// Std
+#include <string>
+#include <cstdint>
+#include <functional>
+
+namespace whm
+{
+    /// Each loader is measured in a separate child process,
+    /// so the peak resident memory of one does not hide the other
+    class WarehouseBenchmark_t
+    {
+        public:
+            using Loader_t = std::function<void()>;
+
+            WarehouseBenchmark_t(const utils::WhmArgs_t&);
+            WarehouseBenchmark_t(const utils::WhmArgs_t&, const ConfigParser_t&);
+            ~WarehouseBenchmark_t();
+
+            void run();
+
+        protected:
+            void benchmarkOrderImport();
+
+            void measure(const std::string&, Loader_t);
+
+            uint64_t ordersChecksum() const;
+
+        private:
+            ConfigParser_t cfg;
+            utils::WhmArgs_t args;
+    };
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include "Logger.h"
 #include "WarehouseOrder.h"
 #include "WarehouseLayout.h"
+#include "WarehouseArticles.h"
 #include "WarehouseDataGenerator.h"
 
 
@@ -118,13 +119,12 @@ namespace whm
         {
             layout.clearWhOrders();
 
+            auto& whArticles = WarehouseArticles_t::getWhArticles();
+            auto& orders = const_cast<WarehouseOrderBook_t&>(layout.getWhOrders());
+
             for(int32_t orderID = 0; orderID < cfg.getAs<int32_t>("orderCount"); ++orderID)
             {
-                WarehouseOrder_t order;
-                std::vector<WarehouseOrderLine_t> lines;
-
-                order.setWhOrderID(orderID);
-                order.setWhOrderType(WarehouseOrderType_t::E_OUTBOUND_ORDER);
+                orders.addWhOrder(orderID, WarehouseOrderType_t::E_OUTBOUND_ORDER);
 
                 // TODO: Accumulate error from round
                 int32_t lineCount = std::round(normalDist(gen));
@@ -135,43 +135,32 @@ namespace whm
 
                 for(int32_t lineID = 0; lineID < std::max(1, lineCount); ++lineID)
                 {
-                    WarehouseOrderLine_t line(nullptr);
-
                     double prob = uniformDist(gen);
 
-                    line.setWhLineID(lineID);
-                    line.setArticle(lookupArticle(prob));
+                    auto article = lookupArticle(prob);
 
-                    lines.emplace_back(std::move(line));
+                    orders.addWhOrderLine(lineID, whArticles.intern(article), 0);
 
-                    whProductOccurances[line.getArticle()]++;
+                    whProductOccurances[article]++;
                 }
-
-                order.setWhOrderLines(lines);
-                layout.addWhOrder(order);
             }
 
-            auto& orders = const_cast<std::vector<WarehouseOrder_t>&>(layout.getWhOrders());
-
             // Update quantities in generated order lines
-            for(auto& order : orders)
+            for(size_t lineIdx = 0; lineIdx < orders.getLineCount(); ++lineIdx)
             {
-                for(auto& line : order)
-                {
-                    auto article = line.getArticle();
-                    auto articleAdq = whProductsAdq[article];
-                    auto articleOcc = whProductOccurances[article];
+                const auto& article = whArticles.getArticle(orders.getArticleIDs()[lineIdx]);
+                auto articleAdq = whProductsAdq[article];
+                auto articleOcc = whProductOccurances[article];
 
-                    auto quantityMi = articleAdq / static_cast<double>(articleOcc);
-                    auto quantitySigma = 1.0;
+                auto quantityMi = articleAdq / static_cast<double>(articleOcc);
+                auto quantitySigma = 1.0;
 
-                    std::normal_distribution<> quantityDist{quantityMi, quantitySigma};
+                std::normal_distribution<> quantityDist{quantityMi, quantitySigma};
 
-                    auto quantity = quantityDist(gen);
-                    quantity = quantity < 1 ? 1 : quantity;
+                auto quantity = quantityDist(gen);
+                quantity = quantity < 1 ? 1 : quantity;
 
-                    line.setQuantity(quantity);
-                }
+                orders.setQuantity(lineIdx, quantity);
             }
 
             whProductOccurances.clear();
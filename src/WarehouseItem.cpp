@@ -62,12 +62,7 @@ namespace whm
             {
                 for (int32_t j = 0; j < uiItemLoc.getSlotCountY(); j++)
                 {
-                    WarehouseLocationSlot_t slot;
-                    slot.setWhLocRack(whLocRack);
-                    slot.setCoords(std::make_pair(i, j));
-                    slot.setArticle(uiItemLoc.getSlots().at((i * uiItemLoc.getSlotCountY()) + j)->getArticle());
-
-                    whLocRack->setAt(i, j, slot);
+                    whLocRack->setArticle(i, j, uiItemLoc.getSlots().at((i * uiItemLoc.getSlotCountY()) + j)->getArticle());
                 }
             }
         }
@@ -167,7 +162,7 @@ namespace whm
         }
     }
 
-    WarehouseItem_t::WarehousePortContainer_t WarehouseItem_t::getWhPorts() const
+    const WarehouseItem_t::WarehousePortContainer_t& WarehouseItem_t::getWhPorts() const
     {
         return whPorts;
     }
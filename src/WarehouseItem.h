@@ -62,7 +62,7 @@ namespace whm
             int32_t getO() const                { return o; }
             double getWorkload() const          { return workload; }
 
-            WarehousePortContainer_t getWhPorts() const;
+            const WarehousePortContainer_t& getWhPorts() const;
             WarehouseLocationRack_t* getWhLocationRack() const;
 
             void dump() const;
@@ -8,16 +8,31 @@
  */
 
 // Std
+#include <thread>
+#include <cstdio>
 #include <fstream>
+#include <charconv>
 #include <iostream>
+#include <iterator>
 #include <algorithm>
+#include <exception>
+#include <unordered_set>
+#include <unordered_map>
+
+// Unix
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // Local
 #include "Logger.h"
 #include "WarehouseItem.h"
 #include "WarehouseOrder.h"
+#include "WarehouseArticles.h"
 #include "WarehouseLayout.h"
 #include "WarehouseConnection.h"
+#include "WarehouseOrderParser.h"
 #include "WarehousePathFinder.h"
 #include "WarehouseLocationRack.h"
 
@@ -65,6 +80,8 @@ namespace whm
         {
             whConns.emplace_back(new WarehouseConnection_t{ *uiConn });
         }
+
+        this->getWhGraph();
     }
 #endif
 
@@ -152,25 +169,169 @@ namespace whm
         }
 
         delete doc;
+
+        this->getWhGraph();
     }
 
     void WarehouseLayout_t::importCustomerOrders(const std::string& xmlFilename)
     {
-        tinyxml2::XMLDocument* doc = new tinyxml2::XMLDocument();
+        // Binary order file is mapped instead of parsed
+        if(WarehouseOrderBook_t::isBinaryFile(xmlFilename))
+        {
+            whOrders.importBinary(xmlFilename);
+            return;
+        }
 
-        if(doc->LoadFile(xmlFilename.c_str()) != tinyxml2::XML_SUCCESS)
+        // Large files are split among available cores
+        struct stat st{};
+        size_t threadCount{ 1 };
+
+        if(stat(xmlFilename.c_str(), &st) == 0)
+        {
+            threadCount = std::min<size_t>(std::thread::hardware_concurrency(),
+                                           st.st_size / WarehouseOrderParser_t::E_MIN_PARALLEL_CHUNK_SIZE);
+        }
+
+        if(threadCount > 1)
         {
+            importCustomerOrdersParallel(xmlFilename, threadCount);
+            return;
+        }
+
+        auto& whArticles = WarehouseArticles_t::getWhArticles();
+        std::string article;
+
+        // File is streamed in chunks, lines are appended directly to the order book
+        WarehouseOrderParser_t parser{ [&](int32_t whOrderID, WarehouseOrderType_t whOrderType)
+                                       {
+                                           whOrders.addWhOrder(whOrderID, whOrderType);
+                                       },
+                                       [&](int32_t whLineID, std::string_view articleName, int32_t quantity)
+                                       {
+                                           article.assign(articleName.data(), articleName.size());
+                                           whOrders.addWhOrderLine(whLineID, whArticles.intern(article), quantity);
+                                       } };
+
+        parser.parseFile(xmlFilename);
+    }
+
+    void WarehouseLayout_t::importCustomerOrdersParallel(const std::string& xmlFilename, size_t threadCount)
+    {
+        int fd = open(xmlFilename.c_str(), O_RDONLY);
+        struct stat st{};
+
+        if(fd < 0 || fstat(fd, &st))
+        {
+            if(fd >= 0)
+            {
+                close(fd);
+            }
+
             throw std::runtime_error("Failed to parse orders XML!");
         }
 
-        for (tinyxml2::XMLElement* whOrderXml = doc->FirstChildElement("WarehouseOrder"); whOrderXml; whOrderXml = whOrderXml->NextSiblingElement("WarehouseOrder"))
+        if(st.st_size == 0)
         {
-            WarehouseOrder_t whOrder;
-            whOrder.deserializeFromXml(whOrderXml);
-            addWhOrder(std::move(whOrder));
+            close(fd);
+            return;
         }
 
-        delete doc;
+        void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if(data == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to parse orders XML!");
+        }
+
+        auto chunks = WarehouseOrderParser_t::splitChunks(std::string_view(static_cast<const char*>(data), st.st_size), threadCount);
+
+        // Each thread fills its own order book with articles numbered by its own dictionary
+        struct ChunkResult_t
+        {
+            WarehouseOrderBook_t whOrders;
+            WarehouseArticles_t whArticles;
+            std::exception_ptr error;
+        };
+
+        std::vector<ChunkResult_t> results(chunks.size());
+        std::vector<std::thread> workers;
+
+        for(size_t i = 0; i < chunks.size(); ++i)
+        {
+            workers.emplace_back([&chunk = chunks[i], &result = results[i]]()
+                                 {
+                                     try
+                                     {
+                                         std::string article;
+
+                                         WarehouseOrderParser_t parser{ [&](int32_t whOrderID, WarehouseOrderType_t whOrderType)
+                                                                        {
+                                                                            result.whOrders.addWhOrder(whOrderID, whOrderType);
+                                                                        },
+                                                                        [&](int32_t whLineID, std::string_view articleName, int32_t quantity)
+                                                                        {
+                                                                            article.assign(articleName.data(), articleName.size());
+                                                                            result.whOrders.addWhOrderLine(whLineID, result.whArticles.intern(article), quantity);
+                                                                        } };
+
+                                         parser.feed(chunk.data(), chunk.size());
+                                         parser.finish();
+                                     }
+                                     catch(...)
+                                     {
+                                         result.error = std::current_exception();
+                                     }
+                                 });
+        }
+
+        for(auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        munmap(data, st.st_size);
+
+        for(const auto& result : results)
+        {
+            if(result.error)
+            {
+                std::rethrow_exception(result.error);
+            }
+        }
+
+        // Chunks are merged in file order, so the book is the same as after serial import
+        auto& whArticles = WarehouseArticles_t::getWhArticles();
+        size_t orderCount{ whOrders.size() };
+        size_t lineCount{ whOrders.getLineCount() };
+
+        for(const auto& result : results)
+        {
+            orderCount += result.whOrders.size();
+            lineCount += result.whOrders.getLineCount();
+        }
+
+        whOrders.reserve(orderCount, lineCount);
+
+        for(const auto& result : results)
+        {
+            std::vector<int32_t> articleIDs;
+
+            for(const auto& article : result.whArticles.getArticles())
+            {
+                articleIDs.push_back(whArticles.intern(article));
+            }
+
+            for(const auto& whOrder : result.whOrders)
+            {
+                whOrders.addWhOrder(whOrder.getWhOrderID(), whOrder.getWhOrderType());
+
+                for(const auto& whLine : whOrder)
+                {
+                    whOrders.addWhOrderLine(whLine.getWhLineID(), articleIDs[whLine.getArticleID()], whLine.getQuantity());
+                }
+            }
+        }
     }
 
     void WarehouseLayout_t::exportCustomerOrders(const std::string& xmlFilename)
@@ -179,79 +340,198 @@ namespace whm
 
         for(const auto& whOrder : whOrders)
         {
-            whOrder.serializeToXml(doc);
+            tinyxml2::XMLElement* whOrderXml = doc->NewElement( "WarehouseOrder" );
+
+            whOrderXml->SetAttribute( "id", whOrder.getWhOrderID() );
+            whOrderXml->SetAttribute( "type", to_underlying(whOrder.getWhOrderType()) );
+
+            for(const auto& whLine : whOrder)
+            {
+                tinyxml2::XMLElement* whLineXml = doc->NewElement( "WarehouseOrderLine" );
+
+                whLineXml->SetAttribute("id", whLine.getWhLineID());
+                whLineXml->SetAttribute("article_name", whLine.getArticle().c_str());
+                whLineXml->SetAttribute("requested_quantity", whLine.getQuantity());
+
+                whOrderXml->InsertEndChild(whLineXml);
+            }
+
+            doc->InsertEndChild(whOrderXml);
         }
 
         doc->SaveFile(xmlFilename.c_str());
         delete doc;
     }
 
+    void WarehouseLayout_t::exportCustomerOrdersBinary(const std::string& binFilename)
+    {
+        whOrders.exportBinary(binFilename);
+    }
+
     void WarehouseLayout_t::importLocationSlots(const std::string& csvFilename)
     {
-        std::ifstream csvStream;
-        csvStream.open(csvFilename);
+        std::ifstream csvStream(csvFilename, std::ios::binary);
+
+        if(!csvStream.is_open())
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Failed to open locations csv <%s>", csvFilename.c_str());
+            return;
+        }
+
+        // Whole file is read at once and parsed in place
+        std::string csv{ std::istreambuf_iterator<char>(csvStream), std::istreambuf_iterator<char>() };
+        csvStream.close();
+
+        // Rows are validated against (location, x, y) of racks in the layout
+        std::unordered_map<int32_t, WarehouseLocationRack_t*> whRacks;
+
+        for(const auto* whItem : whItems)
+        {
+            if (whItem->getType() == WarehouseItemType_t::E_LOCATION_SHELF)
+            {
+                whRacks[whItem->getWhItemID()] = whItem->getWhLocationRack();
+            }
+        }
+
+        auto& whArticles = WarehouseArticles_t::getWhArticles();
+        std::string article;
+        std::string_view fields[5];
 
         // Ignore header
-        std::string header;
-        std::getline(csvStream, header);
+        size_t pos = csv.find('\n');
+        pos = pos == std::string::npos ? csv.size() : pos + 1;
 
-        std::for_each(whItems.begin(), whItems.end(),
-                      [&](const WarehouseItem_t* whItem) -> void
-                      {
-                          if (whItem->getType() == WarehouseItemType_t::E_LOCATION_SHELF)
-                          {
-                              whItem->getWhLocationRack()->importSlots(csvStream);
-                          }
-                      });
+        while(pos < csv.size())
+        {
+            size_t end = csv.find('\n', pos);
+            end = end == std::string::npos ? csv.size() : end;
 
-        csvStream.close();
+            std::string_view row(csv.data() + pos, end - pos);
+            pos = end + 1;
+
+            if(!row.empty() && row.back() == '\r')
+            {
+                row.remove_suffix(1);
+            }
+
+            if(row.empty())
+            {
+                continue;
+            }
+
+            size_t fieldCount{ 0 };
+
+            for(size_t start = 0; fieldCount < 5; ++fieldCount)
+            {
+                size_t sep = fieldCount < 4 ? row.find(';', start) : row.size();
+
+                if(sep == std::string_view::npos)
+                {
+                    break;
+                }
+
+                fields[fieldCount] = row.substr(start, sep - start);
+                start = sep + 1;
+            }
+
+            int32_t id{ 0 }, quantity{ 0 };
+            size_t x{ 0 }, y{ 0 };
+
+            auto parse = [](std::string_view field, auto& value) -> bool
+                         {
+                             auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), value);
+                             return ec == std::errc() && ptr == field.data() + field.size();
+                         };
+
+            if(fieldCount != 5 || !parse(fields[0], id) || !parse(fields[1], x) || !parse(fields[2], y) || !parse(fields[4], quantity))
+            {
+                std::cerr << "Incorrect csv value!" << std::endl;
+                continue;
+            }
+
+            auto it = whRacks.find(id);
+
+            if(it == whRacks.end() ||
+               x >= static_cast<size_t>(it->second->getSlotCountX()) ||
+               y >= static_cast<size_t>(it->second->getSlotCountY()))
+            {
+                std::cerr << "Warehouse layout is not matching this csv!" << std::endl;
+                continue;
+            }
+
+            article.assign(fields[3].data(), fields[3].size());
+            it->second->importSlot(x, y, whArticles.intern(article), quantity);
+        }
     }
 
     void WarehouseLayout_t::exportLocationSlots(const std::string& csvFilename)
     {
-        std::ofstream csvStream;
-        csvStream.open(csvFilename);
-
         // Create header
-        csvStream << "Warehouse location ID;Slot X;Slot Y;Article;Quantity" << std::endl;
+        std::string csv{ "Warehouse location ID;Slot X;Slot Y;Article;Quantity\n" };
 
         std::for_each(whItems.begin(), whItems.end(),
                       [&](const WarehouseItem_t* whItem) -> void
                       {
                           if (whItem->getType() == WarehouseItemType_t::E_LOCATION_SHELF)
                           {
-                              whItem->getWhLocationRack()->exportSlots(csvStream);
+                              whItem->getWhLocationRack()->exportSlots(csv);
                           }
                       });
 
+        // Written aside and renamed, so the file is never left half written
+        std::string tmpFilename = csvFilename + ".tmp";
+        std::ofstream csvStream(tmpFilename, std::ios::binary | std::ios::trunc);
+
+        csvStream.write(csv.data(), csv.size());
         csvStream.close();
+
+        if(!csvStream || std::rename(tmpFilename.c_str(), csvFilename.c_str()))
+        {
+            std::remove(tmpFilename.c_str());
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Failed to export locations csv <%s>", csvFilename.c_str());
+        }
     }
 
     void WarehouseLayout_t::importArticles(const std::string& csvFilename, std::vector<std::string>& articles)
     {
-        std::ifstream csvStream;
-        csvStream.open(csvFilename);
+        std::ifstream csvStream(csvFilename, std::ios::binary);
+        std::string csv{ std::istreambuf_iterator<char>(csvStream), std::istreambuf_iterator<char>() };
+        csvStream.close();
 
-        // Ignore header
-        std::string header;
-        std::getline(csvStream, header);
+        auto& whArticles = WarehouseArticles_t::getWhArticles();
+        std::unordered_set<std::string_view> known;
+
+        // Reserved up front, known articles are viewed in place and must not be moved (short names live inside the strings)
+        articles.reserve(articles.size() + std::count(csv.begin(), csv.end(), '\n'));
+
+        for(const auto& article : articles)
+        {
+            known.insert(article);
+        }
+
+        // Ignore header, rows may end with either CRLF or LF
+        size_t pos = csv.find('\n');
+        pos = pos == std::string::npos ? csv.size() : pos + 1;
 
-        while(csvStream)
+        while(pos < csv.size())
         {
-            std::string article;
-            std::getline(csvStream, article);
+            size_t end = csv.find('\n', pos);
+            end = end == std::string::npos ? csv.size() : end;
 
-            if(!article.empty())
+            std::string_view article(csv.data() + pos, end - pos);
+            pos = end + 1;
+
+            if(!article.empty() && article.back() == '\r')
             {
-                article.pop_back();
-                if(std::find(articles.begin(), articles.end(), article) == articles.end())
-                {
-                    articles.push_back(std::move(article));
-                }
+                article.remove_suffix(1);
             }
-        }
 
-        csvStream.close();
+            if(!article.empty() && known.insert(article).second)
+            {
+                articles.emplace_back(article);
+                whArticles.intern(articles.back());
+            }
+        }
     }
 
     void WarehouseLayout_t::exportArticles(const std::string& csvFilename, std::vector<std::string>& articles)
@@ -271,17 +551,21 @@ namespace whm
 
     void WarehouseLayout_t::addWhItem(WarehouseItem_t* i)
     {
+        whGraphValid = false;
+        whPathsValid = false;
         whItems.push_back(i);
     }
 
     void WarehouseLayout_t::addWhConn(WarehouseConnection_t* c)
     {
+        whGraphValid = false;
+        whPathsValid = false;
         whConns.push_back(c);
     }
 
     void WarehouseLayout_t::addWhOrder(const WarehouseOrder_t& o)
     {
-        whOrders.push_back(o);
+        whOrders.addWhOrder(o);
     }
 
     const WarehouseLayout_t::WarehouseItemContainer_t& WarehouseLayout_t::getWhItems() const
@@ -299,6 +583,28 @@ namespace whm
         return whOrders;
     }
 
+    const WarehouseLayoutGraph_t& WarehouseLayout_t::getWhGraph() const
+    {
+        if(!whGraphValid)
+        {
+            whGraph.build(whItems, whRatio);
+            whGraphValid = true;
+        }
+
+        return whGraph;
+    }
+
+    const WarehousePathFinder_t& WarehouseLayout_t::getWhPathFinder() const
+    {
+        if(!whPathsValid)
+        {
+            whPathFinder.updatePaths(getWhGraph());
+            whPathsValid = true;
+        }
+
+        return whPathFinder;
+    }
+
     void WarehouseLayout_t::dump() const
     {
         std::cout << "*******************************************************" << std::endl;
@@ -321,11 +627,10 @@ namespace whm
 
         std::cout << std::endl << std::endl;
 
-        std::for_each(whOrders.begin(), whOrders.end(),
-                      [](const auto& whOrder) -> void
-                      {
-                          whOrder.dump();
-                      });
+        for(const auto& whOrder : whOrders)
+        {
+            whOrder.dump();
+        }
     }
 
     void WarehouseLayout_t::clearWhOrders()
@@ -349,6 +654,9 @@ namespace whm
 
         whItems.clear();
         whConns.clear();
+        whGraph.clear();
+        whGraphValid = false;
+        whPathsValid = false;
     }
 
     void WarehouseLayout_t::eraseWhItem(WarehouseItem_t* i)
@@ -361,6 +669,8 @@ namespace whm
 
         if (found != whItems.end())
         {
+            whGraphValid = false;
+            whPathsValid = false;
             whItems.erase(found);
         }
     }
@@ -375,22 +685,15 @@ namespace whm
 
         if (found != whConns.end())
         {
+            whGraphValid = false;
+            whPathsValid = false;
             whConns.erase(found);
         }
     }
 
     void WarehouseLayout_t::eraseWhOrder(const WarehouseOrder_t& o)
     {
-        auto found = std::find_if(whOrders.begin(), whOrders.end(),
-                        [&](const auto& whOrder) -> bool
-                        {
-                            return whOrder.getWhOrderID() == o.getWhOrderID();
-                        });
-
-        if (found != whOrders.end())
-        {
-            whOrders.erase(found);
-        }
+        whOrders.eraseWhOrder(o.getWhOrderID());
     }
 
     int32_t WarehouseLayout_t::getRatio() const
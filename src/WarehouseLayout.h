@@ -12,6 +12,10 @@
 #include <vector>
 #include <utility>
 
+#include "WarehouseOrderBook.h"
+#include "WarehouseLayoutGraph.h"
+#include "WarehousePathFinder.h"
+
 #ifdef WHM_GUI
 namespace whm
 {
@@ -33,7 +37,7 @@ namespace whm
         using WarehouseDimensions_t = std::pair<int32_t, int32_t>;
         using WarehouseItemContainer_t = std::vector<WarehouseItem_t*>;
         using WarehouseConnContainer_t = std::vector<WarehouseConnection_t*>;
-        using WarehouseOrderContainer_t = std::vector<WarehouseOrder_t>;
+        using WarehouseOrderContainer_t = WarehouseOrderBook_t;
 
         public:
             WarehouseLayout_t();
@@ -55,7 +59,9 @@ namespace whm
 
             // Customer order import/export
             void importCustomerOrders(const std::string&);
+            void importCustomerOrdersParallel(const std::string&, size_t);
             void exportCustomerOrders(const std::string&);
+            void exportCustomerOrdersBinary(const std::string&);
 
             // Articles import/export
             void importArticles(const std::string&, std::vector<std::string>&);
@@ -64,6 +70,8 @@ namespace whm
             const WarehouseItemContainer_t& getWhItems() const;
             const WarehouseConnContainer_t& getWhConns() const;
             const WarehouseOrderContainer_t& getWhOrders() const;
+            const WarehouseLayoutGraph_t& getWhGraph() const;
+            const WarehousePathFinder_t& getWhPathFinder() const;
 
             void addWhItem(WarehouseItem_t*);
             void addWhConn(WarehouseConnection_t*);
@@ -87,5 +95,14 @@ namespace whm
             WarehouseItemContainer_t whItems;
             WarehouseConnContainer_t whConns;
             WarehouseOrderContainer_t whOrders;
+
+            // Rebuilt on first access after items or connections change
+            mutable WarehouseLayoutGraph_t whGraph;
+            mutable bool whGraphValid{ false };
+
+            // Updated from the graph on first access after it changes, kept when the layout is cleared
+            // so that layout rebuilt with few edits recalculates only affected paths
+            mutable WarehousePathFinder_t whPathFinder;
+            mutable bool whPathsValid{ false };
     };
 }
\ No newline at end of file
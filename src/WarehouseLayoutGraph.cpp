@@ -0,0 +1,134 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseLayoutGraph.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Immutable connectivity graph of warehouse layout (compressed sparse rows)
+ */
+
+// Std
+#include <iostream>
+#include <algorithm>
+
+// Local
+#include "Logger.h"
+#include "WarehousePort.h"
+#include "WarehouseItem.h"
+#include "WarehouseConnection.h"
+#include "WarehouseLayoutGraph.h"
+
+namespace whm
+{
+    namespace
+    {
+        uint8_t nodeFlags(WarehouseItemType_t type)
+        {
+            switch(type)
+            {
+                case WarehouseItemType_t::E_CONVEYOR:           return WarehouseLayoutGraph_t::E_NODE_CONVEYOR;
+                case WarehouseItemType_t::E_CONVEYOR_HUB:       return WarehouseLayoutGraph_t::E_NODE_CONVEYOR | WarehouseLayoutGraph_t::E_NODE_HUB;
+                case WarehouseItemType_t::E_LOCATION_SHELF:     return WarehouseLayoutGraph_t::E_NODE_LOCATION;
+                case WarehouseItemType_t::E_WAREHOUSE_ENTRANCE: return WarehouseLayoutGraph_t::E_NODE_ENTRANCE;
+                case WarehouseItemType_t::E_WAREHOUSE_DISPATCH: return WarehouseLayoutGraph_t::E_NODE_DISPATCH;
+                case WarehouseItemType_t::E_WAREHOUSE_BUFFER:   return WarehouseLayoutGraph_t::E_NODE_BUFFER;
+            }
+
+            return 0;
+        }
+    }
+
+    WarehouseLayoutGraph_t::WarehouseLayoutGraph_t()
+    {
+        offsets.push_back(0);
+    }
+
+    WarehouseLayoutGraph_t::~WarehouseLayoutGraph_t()
+    {
+
+    }
+
+    void WarehouseLayoutGraph_t::build(const std::vector<WarehouseItem_t*>& whItems, int32_t ratio)
+    {
+        clear();
+
+        itemIDs.reserve(whItems.size());
+        lengths.reserve(whItems.size());
+        flags.reserve(whItems.size());
+        offsets.reserve(whItems.size() + 1);
+
+        for(const auto* whItem : whItems)
+        {
+            nodeIndices[whItem->getWhItemID()] = itemIDs.size();
+
+            itemIDs.push_back(whItem->getWhItemID());
+            lengths.push_back(whItem->getW() / ratio);
+            flags.push_back(nodeFlags(whItem->getType()));
+        }
+
+        // Both ends of each connection are examined, the one which is not the item itself is neighbour
+        for(uint32_t node = 0; node < whItems.size(); ++node)
+        {
+            for(const auto* whPort : whItems[node]->getWhPorts())
+            {
+                if(!whPort->isConnected())
+                {
+                    continue;
+                }
+
+                const auto* whConn = whPort->getWhConn();
+
+                for(const auto* whEnd : { whConn->getTo(), whConn->getFrom() })
+                {
+                    int32_t neighbour = getNodeIndex(whEnd->getWhItem()->getWhItemID());
+
+                    if(neighbour == E_NO_NODE || static_cast<uint32_t>(neighbour) == node)
+                    {
+                        continue;
+                    }
+
+                    edges.push_back(Edge_t{ static_cast<uint32_t>(neighbour), lengths[neighbour] });
+                }
+            }
+
+            offsets.push_back(edges.size());
+        }
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "Layout graph built: <%zu> nodes, <%zu> edges", getNodeCount(), getEdgeCount());
+    }
+
+    void WarehouseLayoutGraph_t::clear()
+    {
+        itemIDs.clear();
+        lengths.clear();
+        flags.clear();
+        offsets.clear();
+        offsets.push_back(0);
+        edges.clear();
+        nodeIndices.clear();
+    }
+
+    int32_t WarehouseLayoutGraph_t::getNodeIndex(int32_t whItemID) const
+    {
+        auto it = nodeIndices.find(whItemID);
+
+        return it != nodeIndices.end() ? static_cast<int32_t>(it->second) : E_NO_NODE;
+    }
+
+    void WarehouseLayoutGraph_t::dump() const
+    {
+        for(uint32_t node = 0; node < getNodeCount(); ++node)
+        {
+            std::cout << "Node <" << node << "> item <" << itemIDs[node]
+                      << "> flags <" << static_cast<int32_t>(flags[node])
+                      << "> length <" << lengths[node] << "> neighbours:";
+
+            for(const auto& edge : getEdges(node))
+            {
+                std::cout << " " << itemIDs[edge.to];
+            }
+
+            std::cout << std::endl;
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseLayoutGraph.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Immutable connectivity graph of warehouse layout (compressed sparse rows)
+ */
+
+#pragma once
+
+// Std
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+namespace whm
+{
+    class WarehouseItem_t;
+
+    /**
+     * @brief Adjacency of warehouse items frozen after the layout is loaded
+     *
+     * Items are renumbered to dense node indices in the order of layout items.
+     * Neighbours of node n are stored in range <offsets[n], offsets[n + 1]) of the edge array.
+     */
+    class WarehouseLayoutGraph_t
+    {
+        public:
+            enum NodeFlags_t : uint8_t
+            {
+                E_NODE_CONVEYOR = 1 << 0, //< Conveyor or conveyor hub, items are routed through
+                E_NODE_HUB      = 1 << 1, //< Conveyor hub
+                E_NODE_LOCATION = 1 << 2, //< Location shelf
+                E_NODE_ENTRANCE = 1 << 3, //< Warehouse entrance
+                E_NODE_DISPATCH = 1 << 4, //< Warehouse dispatch
+                E_NODE_BUFFER   = 1 << 5  //< Warehouse buffer
+            };
+
+            static constexpr int32_t E_NO_NODE = -1;
+
+            struct Edge_t
+            {
+                uint32_t to;    //< Index of neighbour node
+                int32_t length; //< Length of neighbour item in meters (w / ratio)
+            };
+
+            /**
+             * @brief Range of edges leaving one node
+             */
+            class Edges_t
+            {
+                public:
+                    Edges_t(const Edge_t* first_, const Edge_t* last_) : first{ first_ }, last{ last_ } {}
+
+                    const Edge_t* begin() const { return first; }
+                    const Edge_t* end() const   { return last; }
+
+                    size_t size() const { return last - first; }
+
+                private:
+                    const Edge_t* first;
+                    const Edge_t* last;
+            };
+
+            WarehouseLayoutGraph_t();
+            ~WarehouseLayoutGraph_t();
+
+            void build(const std::vector<WarehouseItem_t*>&, int32_t);
+            void clear();
+
+            size_t getNodeCount() const { return itemIDs.size(); }
+            size_t getEdgeCount() const { return edges.size(); }
+            bool empty() const          { return itemIDs.empty(); }
+
+            int32_t getNodeIndex(int32_t) const;
+
+            int32_t getWhItemID(uint32_t node) const { return itemIDs[node]; }
+            int32_t getLength(uint32_t node) const   { return lengths[node]; }
+            uint8_t getFlags(uint32_t node) const    { return flags[node]; }
+
+            bool isConveyor(uint32_t node) const { return flags[node] & E_NODE_CONVEYOR; }
+
+            Edges_t getEdges(uint32_t node) const { return Edges_t(edges.data() + offsets[node], edges.data() + offsets[node + 1]); }
+
+            void dump() const;
+
+        private:
+            // Per node
+            std::vector<int32_t> itemIDs;
+            std::vector<int32_t> lengths;
+            std::vector<uint8_t> flags;
+            std::vector<uint32_t> offsets;
+
+            // Per edge
+            std::vector<Edge_t> edges;
+
+            std::unordered_map<int32_t, uint32_t> nodeIndices;
+    };
+}
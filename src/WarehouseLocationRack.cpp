@@ -7,33 +7,36 @@
  * @brief   Class representing location rack with slots containing products
  */
 
+#include <charconv>
 #include <iostream>
 #include <algorithm>
 
 #include "Logger.h"
+#include "WarehouseItem.h"
+#include "WarehouseArticles.h"
 #include "WarehouseLocationRack.h"
 
 namespace whm
 {
-    WarehouseLocationRack_t::WarehouseLocationRack_t(WarehouseItem_t* whItem_, size_t slotsX, size_t slotsY)
+    WarehouseLocationRack_t::WarehouseLocationRack_t(WarehouseItem_t* whItem_, size_t slotsX_, size_t slotsY_)
         : whItem{ whItem_ }
     {
-        init(slotsX, slotsY);
+        init(slotsX_, slotsY_);
 
-        for(size_t y = 0; y < slotsY; ++y)
+        for(auto& slot : whSlots)
         {
-            for(size_t x = 0; x < slotsX; ++x)
-            {
-                sortedSlots.push_back(&this->at(x, y));
-            }
+            sortedSlots.push_back(&slot);
         }
 
         std::sort(sortedSlots.begin(), sortedSlots.end(),
-                  [x = slotsX, y = slotsY](WarehouseLocationSlot_t* lhs, WarehouseLocationSlot_t* rhs)
+                  [this](WarehouseLocationSlot_t* lhs, WarehouseLocationSlot_t* rhs)
                   -> bool
                   {
-                      return (lhs->getCoords().first / double(x)) + (lhs->getCoords().second / double(y)) <
-                             (rhs->getCoords().first / double(x)) + (rhs->getCoords().second / double(y)) ;
+                      auto l = getCoords(lhs);
+                      auto r = getCoords(rhs);
+
+                      return (l.first / double(slotsX)) + (l.second / double(slotsY)) <
+                             (r.first / double(slotsX)) + (r.second / double(slotsY)) ;
                   });
     }
 
@@ -49,92 +52,165 @@ namespace whm
 
     WarehouseLocationSlot_t& WarehouseLocationRack_t::at(size_t x, size_t y)
     {
-        return whSlots[y][x];
+        return whSlots[y * slotsX + x];
+    }
+
+    const WarehouseLocationSlot_t& WarehouseLocationRack_t::at(size_t x, size_t y) const
+    {
+        return whSlots[y * slotsX + x];
     }
 
     void WarehouseLocationRack_t::setAt(size_t x, size_t y, const WarehouseLocationSlot_t& s)
     {
-        whSlots[y][x] = s;
+        setArticleAt(y * slotsX + x, s.getArticleID());
+        whSlots[y * slotsX + x].setQuantity(s.getQuantity());
     }
 
-    void WarehouseLocationRack_t::init(size_t x, size_t y)
+    void WarehouseLocationRack_t::setArticle(size_t x, size_t y, const std::string& article)
     {
-        whSlots = LocationSlots_t(y, std::vector<WarehouseLocationSlot_t>(x));
+        setArticleAt(y * slotsX + x, WarehouseArticles_t::getWhArticles().intern(article));
+    }
 
-        for (size_t i = 0; i < whSlots.size(); i++)
+    void WarehouseLocationRack_t::setArticle(WarehouseLocationSlot_t* slot, const std::string& article)
+    {
+        setArticleAt(static_cast<size_t>(slot - whSlots.data()), WarehouseArticles_t::getWhArticles().intern(article));
+    }
+
+    void WarehouseLocationRack_t::setArticleAt(size_t idx, int32_t articleID)
+    {
+        WarehouseLocationSlot_t& slot = whSlots[idx];
+
+        if(slot.articleID == articleID)
+        {
+            return;
+        }
+
+        if(slot.articleID != WarehouseArticles_t::E_NO_ARTICLE)
         {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
+            auto it = articleSlots.find(slot.articleID);
+
+            if(it != articleSlots.end())
             {
-                whSlots[i][j].setWhLocRack(this);
-                whSlots[i][j].setCoords(std::make_pair(j, i));
+                auto& indices = it->second;
+                indices.erase(std::remove(indices.begin(), indices.end(), static_cast<uint32_t>(idx)), indices.end());
+
+                if(indices.empty())
+                {
+                    articleSlots.erase(it);
+                }
             }
         }
+
+        if(articleID != WarehouseArticles_t::E_NO_ARTICLE)
+        {
+            auto& indices = articleSlots[articleID];
+            indices.insert(std::lower_bound(indices.begin(), indices.end(), static_cast<uint32_t>(idx)), static_cast<uint32_t>(idx));
+        }
+
+        slot.articleID = articleID;
+    }
+
+    void WarehouseLocationRack_t::init(size_t x, size_t y)
+    {
+        slotsX = x;
+        slotsY = y;
+
+        articleSlots.clear();
+        whSlots.assign(x * y, WarehouseLocationSlot_t());
+    }
+
+    std::pair<size_t, size_t> WarehouseLocationRack_t::getCoords(const WarehouseLocationSlot_t* slot) const
+    {
+        const size_t idx = static_cast<size_t>(slot - whSlots.data());
+
+        return std::make_pair(idx % slotsX, idx / slotsX);
     }
 
     void WarehouseLocationRack_t::dump() const
     {
         for (size_t i = 0; i < whSlots.size(); i++)
         {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
+            whSlots[i].dump();
+
+            if((i + 1) % slotsX == 0)
             {
-                whSlots[i][j].dump();
+                std::cout << std::endl;
             }
-            std::cout << std::endl;
         }
     }
 
-    void WarehouseLocationRack_t::exportSlots(std::ostream& csvStream) const
+    void WarehouseLocationRack_t::exportSlots(std::string& csvBuffer) const
     {
+        char number[16];
+
+        auto appendNumber = [&](auto value)
+                            {
+                                auto [end, ec] = std::to_chars(number, number + sizeof(number), value);
+                                csvBuffer.append(number, end);
+                            };
+
         for (size_t i = 0; i < whSlots.size(); i++)
         {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
-            {
-                whSlots[i][j].exportSlot(csvStream);
-            }
+            appendNumber(this->whItem->getWhItemID());
+            csvBuffer.push_back(';');
+            appendNumber(i % slotsX);
+            csvBuffer.push_back(';');
+            appendNumber(i / slotsX);
+            csvBuffer.push_back(';');
+            csvBuffer.append(whSlots[i].getArticle());
+            csvBuffer.push_back(';');
+            appendNumber(whSlots[i].getQuantity());
+            csvBuffer.push_back('\n');
         }
     }
 
-    void WarehouseLocationRack_t::importSlots(std::istream& csvStream)
+    void WarehouseLocationRack_t::importSlot(size_t x, size_t y, int32_t articleID, int32_t quantity)
     {
-        for (size_t i = 0; i < whSlots.size(); i++)
-        {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
-            {
-                whSlots[i][j].importSlot(csvStream);
-            }
-        }
+        setArticleAt(y * slotsX + x, articleID);
+        whSlots[y * slotsX + x].setQuantity(quantity);
     }
 
     bool WarehouseLocationRack_t::containsArticle(const std::string& article, int32_t quantity)
     {
-        std::pair<size_t, size_t> c;
-        return containsArticle(article, quantity, c, false);
+        return containsArticle(WarehouseArticles_t::getWhArticles().lookup(article), quantity);
     }
 
     bool WarehouseLocationRack_t::containsArticle(const std::string& article, int32_t quantity, std::pair<size_t, size_t>& coords, bool reple)
     {
-        for (size_t i = 0; i < whSlots.size(); i++)
+        return containsArticle(WarehouseArticles_t::getWhArticles().lookup(article), quantity, coords, reple);
+    }
+
+    bool WarehouseLocationRack_t::containsArticle(int32_t articleID, int32_t quantity)
+    {
+        std::pair<size_t, size_t> c;
+        return containsArticle(articleID, quantity, c, false);
+    }
+
+    bool WarehouseLocationRack_t::containsArticle(int32_t articleID, int32_t quantity, std::pair<size_t, size_t>& coords, bool reple)
+    {
+        auto it = articleSlots.find(articleID);
+
+        if(it == articleSlots.end())
         {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
+            return false;
+        }
+
+        for(uint32_t idx : it->second)
+        {
+            if(reple)
             {
-                if(reple)
-                {
-                    if(whSlots[i][j].getArticle() == article && whSlots[i][j].getQuantity() >= quantity)
-                    {
-                        whSlots[i][j] -= quantity;
-                        coords = std::make_pair(j, i);
-                        return true;
-                    }
-                }
-                else
+                if(whSlots[idx].getQuantity() >= quantity)
                 {
-                    if(whSlots[i][j].getArticle() == article)
-                    {
-                        coords = std::make_pair(j, i);
-                        return true;
-                    }
+                    whSlots[idx] -= quantity;
+                    coords = std::make_pair(idx % slotsX, idx / slotsX);
+                    return true;
                 }
             }
+            else
+            {
+                coords = std::make_pair(idx % slotsX, idx / slotsX);
+                return true;
+            }
         }
 
         return false;
@@ -142,56 +218,47 @@ namespace whm
 
     void WarehouseLocationRack_t::replenishArticle(const std::string& article, int32_t quantity, std::pair<size_t, size_t>& coords)
     {
-        for (size_t i = 0; i < whSlots.size(); i++)
+        replenishArticle(WarehouseArticles_t::getWhArticles().lookup(article), quantity, coords);
+    }
+
+    void WarehouseLocationRack_t::replenishArticle(int32_t articleID, int32_t quantity, std::pair<size_t, size_t>& coords)
+    {
+        auto it = articleSlots.find(articleID);
+
+        if(it != articleSlots.end() && !it->second.empty())
         {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
-            {
-                if(whSlots[i][j].getArticle() == article)
-                {
-                    whSlots[i][j] += quantity;
-                    coords = std::make_pair(j, i);
-                }
-            }
+            const uint32_t idx = it->second.front();
+
+            whSlots[idx] += quantity;
+            coords = std::make_pair(idx % slotsX, idx / slotsX);
         }
     }
 
     void WarehouseLocationRack_t::resetRack(int32_t initQty)
     {
-        for (size_t i = 0; i < whSlots.size(); i++)
+        for (auto& slot : whSlots)
         {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
-            {
-                whSlots[i][j].resetSlot(initQty);
-            }
+            slot.resetSlot(initQty);
         }
     }
 
     int32_t WarehouseLocationRack_t::getSlotCountY() const
     {
-        return static_cast<int32_t>(whSlots.size());
+        return static_cast<int32_t>(slotsY);
     }
 
     int32_t WarehouseLocationRack_t::getSlotCountX() const
     {
-        return static_cast<int32_t>(whSlots.size() > 0 ? whSlots[0].size() : 0);
+        return static_cast<int32_t>(slotsX);
     }
 
     int32_t WarehouseLocationRack_t::getOccupationLevel() const
     {
-        int32_t occLevel{ 0 };
-
-        for (size_t i = 0; i < whSlots.size(); i++)
-        {
-            for (size_t j = 0; j < whSlots[i].size(); j++)
-            {
-                if(whSlots[i][j].isOccupied())
-                {
-                    occLevel++;
-                }
-            }
-        }
-
-        return occLevel;
+        return static_cast<int32_t>(std::count_if(whSlots.begin(), whSlots.end(),
+                                                  [](const WarehouseLocationSlot_t& slot) -> bool
+                                                  {
+                                                      return slot.isOccupied();
+                                                  }));
     }
 
     WarehouseLocationSlot_t* WarehouseLocationRack_t::getFirstFreeSlot()
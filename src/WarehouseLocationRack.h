@@ -10,7 +10,9 @@
 #pragma once
 
 // Std
+#include <string>
 #include <vector>
+#include <unordered_map>
 
 // Local
 #include "WarehouseLocationSlot.h"
@@ -23,30 +25,39 @@ namespace whm
     {
         public:
             using SortedLocationSlots_t = std::vector<WarehouseLocationSlot_t*>;
-            using LocationSlots_t = std::vector<std::vector<WarehouseLocationSlot_t>>;
+            using LocationSlots_t = std::vector<WarehouseLocationSlot_t>;
 
             WarehouseLocationRack_t(WarehouseItem_t*, size_t, size_t);
             ~WarehouseLocationRack_t();
 
             WarehouseLocationSlot_t& at(size_t, size_t);
+            const WarehouseLocationSlot_t& at(size_t, size_t) const;
             void setAt(size_t, size_t, const WarehouseLocationSlot_t&);
 
+            void setArticle(size_t, size_t, const std::string&);
+            void setArticle(WarehouseLocationSlot_t*, const std::string&);
+
             void init(size_t, size_t);
             void resetRack(int32_t);
 
+            bool containsArticle(int32_t, int32_t);
+            bool containsArticle(int32_t, int32_t, std::pair<size_t, size_t>&, bool);
             bool containsArticle(const std::string&, int32_t);
             bool containsArticle(const std::string&, int32_t, std::pair<size_t, size_t>&, bool);
 
+            void replenishArticle(int32_t, int32_t, std::pair<size_t, size_t>&);
             void replenishArticle(const std::string&, int32_t, std::pair<size_t, size_t>&);
 
-            void exportSlots(std::ostream&) const;
-            void importSlots(std::istream&);
+            void exportSlots(std::string&) const;
+            void importSlot(size_t, size_t, int32_t, int32_t);
 
             WarehouseItem_t* getWhItem() const;
 
             int32_t getSlotCountX() const;
             int32_t getSlotCountY() const;
 
+            std::pair<size_t, size_t> getCoords(const WarehouseLocationSlot_t*) const;
+
             const LocationSlots_t& getSlots() const;
             const SortedLocationSlots_t& getSortedSlots() const;
 
@@ -55,10 +66,20 @@ namespace whm
 
             void dump() const;
 
+        protected:
+            void setArticleAt(size_t, int32_t);
+
         private:
+            size_t slotsX{ 0 };
+            size_t slotsY{ 0 };
+
+            // Row-major slots, slot (x, y) is stored at index y * slotsX + x
             LocationSlots_t whSlots;
             SortedLocationSlots_t sortedSlots;
 
+            // Article ID -> row-major indices of slots holding it, kept in ascending order
+            std::unordered_map<int32_t, std::vector<uint32_t>> articleSlots;
+
             WarehouseItem_t* whItem{ nullptr };
     };
 }
@@ -9,12 +9,18 @@
 
 #pragma once
 
-#include <utility>
+// Std
+#include <string>
+#include <cstdint>
 
 namespace whm
 {
-    class WarehouseLocationRack_t;
-
+    /**
+     * @brief Contents of one rack slot, position is given by its index within the rack
+     *
+     * @note Article is changed only through the rack (WarehouseLocationRack_t::setArticle),
+     *       so the rack can keep its article index consistent
+     */
     class WarehouseLocationSlot_t
     {
         public:
@@ -24,8 +30,8 @@ namespace whm
             bool isOccupied() const;
             void resetSlot(int32_t);
 
-            std::string getArticle() const;
-            void setArticle(const std::string&);
+            const std::string& getArticle() const;
+            int32_t getArticleID() const;
 
             int32_t getQuantity() const;
             void setQuantity(const int32_t);
@@ -35,22 +41,12 @@ namespace whm
             // Replenish
             void operator+=(const int32_t);
 
-            std::pair<size_t, size_t> getCoords() const;
-            void setCoords(const std::pair<size_t, size_t>&);
-
-            WarehouseLocationRack_t* getWhLocRack() const;
-            void setWhLocRack(WarehouseLocationRack_t*);
-
-            void exportSlot(std::ostream&) const;
-            void importSlot(std::istream&);
-
             void dump() const;
 
         private:
-            std::string article;
-            size_t x{ 0 };
-            size_t y{ 0 };
+            friend class WarehouseLocationRack_t;
+
+            int32_t articleID{ -1 };
             int32_t quantity{ 0 };
-            WarehouseLocationRack_t* whLocRack{ nullptr };
     };
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseMatrix.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Dense row-major matrix stored in one aligned block
+ */
+
+#pragma once
+
+// Std
+#include <new>
+#include <vector>
+#include <cstdlib>
+#include <cstddef>
+#include <stdexcept>
+
+namespace whm
+{
+    /**
+     * @brief Allocator returning memory aligned for vector instructions
+     */
+    template <typename T, size_t Alignment = 64>
+    struct AlignedAllocator_t
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator_t<U, Alignment>;
+        };
+
+        AlignedAllocator_t() = default;
+
+        template <typename U>
+        AlignedAllocator_t(const AlignedAllocator_t<U, Alignment>&) {}
+
+        T* allocate(size_t n)
+        {
+            // Size given to aligned_alloc has to be multiple of the alignment
+            size_t bytes = (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+            void* p = std::aligned_alloc(Alignment, bytes);
+
+            if(!p)
+            {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T*>(p);
+        }
+
+        void deallocate(T* p, size_t)
+        {
+            std::free(p);
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator_t<U, Alignment>&) const { return true; }
+
+        template <typename U>
+        bool operator!=(const AlignedAllocator_t<U, Alignment>&) const { return false; }
+    };
+
+    /**
+     * @brief Square or rectangular matrix, element (y, x) is at y * cols + x
+     *
+     * operator() is unchecked and meant for hot loops, at() checks bounds.
+     */
+    template <typename T>
+    class WarehouseMatrix_t
+    {
+        public:
+            WarehouseMatrix_t() = default;
+
+            void assign(size_t rows_, size_t cols_, const T& value)
+            {
+                rows = rows_;
+                cols = cols_;
+                values.assign(rows * cols, value);
+            }
+
+            void clear()
+            {
+                rows = 0;
+                cols = 0;
+                values.clear();
+            }
+
+            T& operator()(size_t y, size_t x)             { return values[y * cols + x]; }
+            const T& operator()(size_t y, size_t x) const { return values[y * cols + x]; }
+
+            T& at(size_t y, size_t x)
+            {
+                return const_cast<T&>(static_cast<const WarehouseMatrix_t&>(*this).at(y, x));
+            }
+
+            const T& at(size_t y, size_t x) const
+            {
+                if(y >= rows || x >= cols)
+                {
+                    throw std::out_of_range("Matrix index out of range!");
+                }
+
+                return values[y * cols + x];
+            }
+
+            T* row(size_t y)             { return values.data() + y * cols; }
+            const T* row(size_t y) const { return values.data() + y * cols; }
+
+            T* data()             { return values.data(); }
+            const T* data() const { return values.data(); }
+
+            size_t size() const { return values.size(); }
+            size_t getRows() const { return rows; }
+            size_t getCols() const { return cols; }
+            bool empty() const { return values.empty(); }
+
+        private:
+            size_t rows{ 0 };
+            size_t cols{ 0 };
+            std::vector<T, AlignedAllocator_t<T>> values;
+    };
+}
@@ -12,7 +12,9 @@
 // Std
 #include <map>
 #include <set>
+#include <sstream>
 #include <utility>
+#include <unordered_map>
 #include <iostream>
 #include <signal.h>
 #include <algorithm>
@@ -21,6 +23,7 @@
 #include "Logger.h"
 #include "WarehouseItem.h"
 #include "WarehouseLayout.h"
+#include "WarehouseArticles.h"
 #include "WarehouseLocationRack.h"
 #include "WarehouseOptimizerBase.h"
 #include "WarehouseSimulatorSIMLIB.h"
@@ -67,6 +70,7 @@ namespace whm
             {
                 for(auto* slot : item->getWhLocationRack()->getSortedSlots())
                 {
+                    slotRackEnc.push_back(item->getWhLocationRack());
                     slotEnc.insert(std::make_pair(slotID++, slot));
                 }
             }
@@ -177,18 +181,28 @@ namespace whm
 
     void WarehouseOptimizerBase_t::initPopulationWeights(std::vector<Solution_t>& pop)
     {
-        std::vector<std::string> articles;
-        whm::WarehouseLayout_t::getWhLayout().importArticles(args.articlesPath, articles);
         whm::WarehouseLayout_t::getWhLayout().importLocationSlots(cfg.getAs<std::string>("initialWeights"));
 
-        for(auto& article : articles)
+        // Articles were imported in init, slots are grouped by article ID in one pass
+        std::unordered_map<int32_t, std::vector<int32_t>> articleSlots;
+
+        for(auto& slot : slotEnc)
         {
-            for(auto& slot : slotEnc)
+            if(slot.second->isOccupied())
             {
-                if(article == slot.second->getArticle())
-                {
-                    pop[0].genes.push_back(slot.first);
-                }
+                articleSlots[slot.second->getArticleID()].push_back(slot.first);
+            }
+        }
+
+        const auto& whArticles = WarehouseArticles_t::getWhArticles();
+
+        for(auto& sku : skuEnc)
+        {
+            auto it = articleSlots.find(whArticles.lookup(sku.second));
+
+            if(it != articleSlots.end())
+            {
+                pop[0].genes.insert(pop[0].genes.end(), it->second.begin(), it->second.end());
             }
         }
 
@@ -203,7 +217,7 @@ namespace whm
         // Clear current allocations first
         for(auto& slot : slotEnc)
         {
-            slot.second->setArticle(std::string());
+            slotRackEnc[slot.first]->setArticle(slot.second, std::string());
         }
 
         // Set new allocations
@@ -212,7 +226,7 @@ namespace whm
             auto itSku  = skuEnc.find(i);
             auto itSlot = slotEnc.find(ind.at(i));
 
-            itSlot->second->setArticle(itSku->second);
+            slotRackEnc[itSlot->first]->setArticle(itSlot->second, itSku->second);
         }
     }
 
@@ -227,9 +241,18 @@ namespace whm
 
     void WarehouseOptimizerBase_t::saveFitnessPlot() const
     {
-        // Plot fitness dump to output
-        std::for_each(histFitness.begin(), histFitness.end(), [](double v){ std::cout << v << ", "; });
-        std::cout << std::endl;
+        if(!Logger_t::getLogger().isEnabled(LogLevel_t::E_DEBUG))
+        {
+            return;
+        }
+
+        // Plot fitness dump to output, in order with log messages
+        std::ostringstream plot;
+
+        std::for_each(histFitness.begin(), histFitness.end(), [&plot](double v){ plot << v << ", "; });
+        plot << '\n';
+
+        Logger_t::getLogger().printRaw(plot.str());
     }
 
     void WarehouseOptimizerBase_t::saveBestSolution(std::vector<int32_t>& chromosome) const
@@ -237,20 +260,31 @@ namespace whm
         // Update article/location allocation
         updateAllocations(chromosome);
 
-        // Export allocation to a csv file
-        whm::WarehouseLayout_t::getWhLayout().exportLocationSlots(args.locationsPath);
+        // Export allocation to a csv file, unless the best solution did not change since the last export
+        if(chromosome != savedSolution)
+        {
+            whm::WarehouseLayout_t::getWhLayout().exportLocationSlots(args.locationsPath);
+            savedSolution = chromosome;
+        }
     }
 
     std::vector<int32_t> WarehouseOptimizerBase_t::precalculateArticleWeights()
     {
         std::vector<int32_t> sortedArticleEncs;
         std::map<std::string, int32_t> articleWeightsMap;
+        std::vector<int32_t> articleCounts(WarehouseArticles_t::getWhArticles().size());
+
+        // Count lines per article over flat article ID array of the order book
+        for(int32_t articleID : whm::WarehouseLayout_t::getWhLayout().getWhOrders().getArticleIDs())
+        {
+            articleCounts[articleID]++;
+        }
 
-        for(auto& order : whm::WarehouseLayout_t::getWhLayout().getWhOrders())
+        for(size_t articleID = 0; articleID < articleCounts.size(); ++articleID)
         {
-            for(auto& line : order.getWhOrderLines())
+            if(articleCounts[articleID])
             {
-                articleWeightsMap[line.getArticle()]++;
+                articleWeightsMap[WarehouseArticles_t::getWhArticles().getArticle(articleID)] = articleCounts[articleID];
             }
         }
 
@@ -305,8 +339,7 @@ namespace whm
 
         auto genes = std::vector<int32_t>(cfg.getAs<int32_t>("numberDimensions"));
 
-        pathFinder.clearPrecalculatedPaths();
-        pathFinder.precalculatePaths(whm::WarehouseLayout_t::getWhLayout().getWhItems());
+        pathFinder.sharePaths(whm::WarehouseLayout_t::getWhLayout().getWhPathFinder());
 
         auto articleWeights = precalculateArticleWeights();
 
@@ -399,7 +432,10 @@ namespace whm
                 if(s == 0)
                 {
                     close(infd);
-                    exit(0);
+
+                    // Static destructors belong to the parent (e.g. logger would wait for its flusher thread)
+                    whm::Logger_t::getLogger().flush();
+                    _exit(0);
                 }
                 else if(s < (ssize_t)sizeof(int32_t))
                 {
@@ -86,6 +86,7 @@ namespace whm
             // Generic sku/slot encoding
             std::map<int32_t, std::string> skuEnc;
             std::map<int32_t, WarehouseLocationSlot_t*> slotEnc;
+            std::vector<WarehouseLocationRack_t*> slotRackEnc;
 
             // Simulation handler
             WarehouseSimulatorSIMLIB_t simulator;
@@ -96,6 +97,9 @@ namespace whm
             // Fitness history for plot
             std::vector<double> histFitness;
 
+            // Last solution exported to the locations csv
+            mutable std::vector<int32_t> savedSolution;
+
             WarehousePathFinder_t pathFinder;
 
 #           ifdef WHM_GUI
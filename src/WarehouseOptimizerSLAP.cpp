@@ -20,6 +20,7 @@
 #include "Logger.h"
 #include "WarehouseItem.h"
 #include "WarehouseLayout.h"
+#include "WarehouseArticles.h"
 #include "WarehousePathFinder.h"
 #include "WarehouseLocationRack.h"
 #include "WarehouseOptimizerSLAP.h"
@@ -41,7 +42,7 @@ namespace whm
 
     void WarehouseOptimizerSLAP_t::init()
     {
-        pathFinder.precalculatePaths(whm::WarehouseLayout_t::getWhLayout().getWhItems());
+        pathFinder.sharePaths(whm::WarehouseLayout_t::getWhLayout().getWhPathFinder());
     }
 
     std::vector<int32_t> WarehouseOptimizerSLAP_t::precalculateSlotHeats()
@@ -90,12 +91,19 @@ namespace whm
     {
         std::vector<int32_t> sortedArticleEncs;
         std::map<std::string, int32_t> articleWeightsMap;
+        std::vector<int32_t> articleCounts(WarehouseArticles_t::getWhArticles().size());
 
-        for(auto& order : whm::WarehouseLayout_t::getWhLayout().getWhOrders())
+        // Count lines per article over flat article ID array of the order book
+        for(int32_t articleID : whm::WarehouseLayout_t::getWhLayout().getWhOrders().getArticleIDs())
         {
-            for(auto& line : order.getWhOrderLines())
+            articleCounts[articleID]++;
+        }
+
+        for(size_t articleID = 0; articleID < articleCounts.size(); ++articleID)
+        {
+            if(articleCounts[articleID])
             {
-                articleWeightsMap[line.getArticle()]++;
+                articleWeightsMap[WarehouseArticles_t::getWhArticles().getArticle(articleID)] = articleCounts[articleID];
             }
         }
 
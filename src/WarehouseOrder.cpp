@@ -49,7 +49,18 @@ namespace whm
 
     void WarehouseOrder_t::setWhOrderLines(std::vector<WarehouseOrderLine_t> newLines)
     {
-        this->whOrderLines = newLines;
+        this->whOrderLines = std::move(newLines);
+    }
+
+    void WarehouseOrder_t::addWhOrderLine(WarehouseOrderLine_t newLine)
+    {
+        this->whOrderLines.emplace_back(std::move(newLine));
+    }
+
+    void WarehouseOrder_t::clearWhOrderLines()
+    {
+        // Keeps allocated capacity, so recycled orders (replenishments) can be refilled cheaply
+        this->whOrderLines.clear();
     }
 
     void WarehouseOrder_t::dump() const
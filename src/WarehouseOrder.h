@@ -32,6 +32,8 @@ namespace whm
 
             typename WarehouseOrderLineContainer_t::iterator begin() { return whOrderLines.begin(); }
             typename WarehouseOrderLineContainer_t::iterator end() { return whOrderLines.end(); }
+            typename WarehouseOrderLineContainer_t::const_iterator begin() const { return whOrderLines.begin(); }
+            typename WarehouseOrderLineContainer_t::const_iterator end() const { return whOrderLines.end(); }
 
             void setWhOrderID(int32_t);
             int32_t getWhOrderID() const;
@@ -42,6 +44,9 @@ namespace whm
             void setWhOrderLines(WarehouseOrderLineContainer_t);
             const WarehouseOrderLineContainer_t& getWhOrderLines() const;
 
+            void addWhOrderLine(WarehouseOrderLine_t);
+            void clearWhOrderLines();
+
             void deserializeFromXml(tinyxml2::XMLElement*);
             void serializeToXml(tinyxml2::XMLDocument* doc) const;
             void dump() const;
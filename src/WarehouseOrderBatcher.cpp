@@ -0,0 +1,794 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseOrderBatcher.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Grouping of orders into pick waves sharing one tour
+ */
+
+#ifdef WHM_SIM
+
+// Std
+#include <queue>
+#include <tuple>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <unordered_map>
+
+// Local
+#include "Logger.h"
+#include "WarehouseItem.h"
+#include "WarehouseLayout.h"
+#include "WarehouseTourSearch.h"
+#include "WarehouseLocationRack.h"
+#include "WarehouseOrderBatcher.h"
+
+namespace whm
+{
+    namespace
+    {
+        /// Local search stops earlier if no order could be moved or swapped
+        constexpr int32_t E_MAX_IMPROVE_PASSES = 10;
+
+        std::vector<int32_t> unite(const std::vector<int32_t>& lhs, const std::vector<int32_t>& rhs)
+        {
+            std::vector<int32_t> united;
+            united.reserve(lhs.size() + rhs.size());
+
+            std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(united));
+
+            return united;
+        }
+
+        std::vector<int32_t> without(const std::vector<int32_t>& values, int32_t value)
+        {
+            std::vector<int32_t> rest;
+            rest.reserve(values.size());
+
+            std::copy_if(values.begin(), values.end(), std::back_inserter(rest), [value](int32_t v) { return v != value; });
+
+            return rest;
+        }
+    }
+
+    WarehouseOrderBatcher_t::WarehouseOrderBatcher_t(const WarehousePathFinder_t& whPathFinder_, const ConfigParser_t& cfg)
+        : whPathFinder{ whPathFinder_ }
+        , capacity{ static_cast<size_t>(std::max(cfg.getAs<int32_t>("batchCapacity"), 1)) }
+        , maxLines{ cfg.isSet("batchMaxLines") ? static_cast<size_t>(std::max(cfg.getAs<int32_t>("batchMaxLines"), 0)) : 0 }
+        , neighbourCount{ cfg.isSet("batchNeighbours") ? static_cast<size_t>(std::max(cfg.getAs<int32_t>("batchNeighbours"), 1)) : 8 }
+        , method{ cfg.isSet("batchMethod") ? cfg.getAs<std::string>("batchMethod") : std::string("savings") }
+        , localSearch{ cfg.isSet("batchLocalSearch") && cfg.getAs<bool>("batchLocalSearch") }
+    {
+        if(method != "savings" && method != "seed")
+        {
+            throw std::runtime_error("Unknown batching method <" + method + ">!");
+        }
+    }
+
+    const std::vector<WarehouseOrderBatcher_t::Batch_t>& WarehouseOrderBatcher_t::createBatches(const WarehouseOrderBook_t& whOrders, int32_t entranceID, int32_t dispatchID)
+    {
+        // Articles move between locations during optimization, so everything is found again
+        findOrderNodes(whOrders, entranceID, dispatchID);
+        calcDistances();
+
+        orderCosts.clear();
+
+        for(const auto& nodes : orderNodes)
+        {
+            orderCosts.push_back(routeCost(nodes));
+        }
+
+        findOrderNeighbours();
+
+        if(method == "seed")
+        {
+            seedBatching();
+        }
+        else
+        {
+            savingsBatching();
+        }
+
+        if(localSearch)
+        {
+            improveBatches();
+        }
+
+        batches.clear();
+
+        for(const auto& group : groups)
+        {
+            if(group.orders.empty())
+            {
+                continue;
+            }
+
+            Batch_t batch;
+            batch.orders = group.orders;
+            batch.cost = group.cost;
+
+            auto nodes = route(group.nodes);
+
+            // Entrance and dispatch are not part of the tour
+            for(size_t i = 1; i + 1 < nodes.size(); ++i)
+            {
+                batch.tour.push_back(nodeItemIDs[nodes[i]]);
+            }
+
+            batches.push_back(std::move(batch));
+        }
+
+        // Waves are released in order of their first order
+        std::sort(batches.begin(), batches.end(),
+                  [](const Batch_t& lhs, const Batch_t& rhs) -> bool
+                  {
+                      return lhs.orders.front() < rhs.orders.front();
+                  });
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "[Batching] <%zu> orders in <%zu> batches (%s), travel <%lld> [m] instead of <%lld> [m]",
+                                    whOrders.size(), batches.size(), method.c_str(),
+                                    static_cast<long long>(getBatchedCost()), static_cast<long long>(getSingleOrderCost()));
+
+        return batches;
+    }
+
+    std::vector<WarehouseOrderBatcher_t::PickLine_t> WarehouseOrderBatcher_t::getPickLines(const Batch_t& batch) const
+    {
+        std::vector<PickLine_t> pickLines;
+
+        auto appendLines = [&](int32_t node)
+                           {
+                               for(int32_t orderIdx : batch.orders)
+                               {
+                                   const auto& nodes = lineNodes[orderIdx];
+
+                                   for(size_t lineIdx = 0; lineIdx < nodes.size(); ++lineIdx)
+                                   {
+                                       if(nodes[lineIdx] == node)
+                                       {
+                                           pickLines.push_back(PickLine_t{ orderIdx, static_cast<int32_t>(lineIdx) });
+                                       }
+                                   }
+                               }
+                           };
+
+        for(int32_t whItemID : batch.tour)
+        {
+            appendLines(static_cast<int32_t>(std::find(nodeItemIDs.begin(), nodeItemIDs.end(), whItemID) - nodeItemIDs.begin()));
+        }
+
+        // Articles which are not stored anywhere, simulator reports them
+        appendLines(-1);
+
+        return pickLines;
+    }
+
+    int64_t WarehouseOrderBatcher_t::getSingleOrderCost() const
+    {
+        return std::accumulate(orderCosts.begin(), orderCosts.end(), int64_t{ 0 });
+    }
+
+    int64_t WarehouseOrderBatcher_t::getBatchedCost() const
+    {
+        return std::accumulate(batches.begin(), batches.end(), int64_t{ 0 },
+                               [](int64_t sum, const Batch_t& batch) { return sum + batch.cost; });
+    }
+
+    void WarehouseOrderBatcher_t::findOrderNodes(const WarehouseOrderBook_t& whOrders, int32_t entranceID, int32_t dispatchID)
+    {
+        nodeItemIDs = { entranceID, dispatchID };
+        orderNodes.assign(whOrders.size(), std::vector<int32_t>());
+        lineNodes.assign(whOrders.size(), std::vector<int32_t>());
+
+        std::vector<WarehouseItem_t*> whShelves;
+
+        for(auto* whItem : WarehouseLayout_t::getWhLayout().getWhItems())
+        {
+            if(whItem->getType() == WarehouseItemType_t::E_LOCATION_SHELF)
+            {
+                whShelves.push_back(whItem);
+            }
+        }
+
+        std::unordered_map<int32_t, int32_t> articleNodes;
+        std::unordered_map<int32_t, int32_t> itemNodes;
+
+        auto lookupNode = [&](int32_t articleID) -> int32_t
+                          {
+                              auto it = articleNodes.find(articleID);
+
+                              if(it != articleNodes.end())
+                              {
+                                  return it->second;
+                              }
+
+                              int32_t node{ -1 };
+
+                              for(auto* whShelf : whShelves)
+                              {
+                                  if(whShelf->getWhLocationRack()->containsArticle(articleID, 0))
+                                  {
+                                      auto [itemIt, inserted] = itemNodes.try_emplace(whShelf->getWhItemID(), static_cast<int32_t>(nodeItemIDs.size()));
+
+                                      if(inserted)
+                                      {
+                                          nodeItemIDs.push_back(whShelf->getWhItemID());
+                                      }
+
+                                      node = itemIt->second;
+                                      break;
+                                  }
+                              }
+
+                              articleNodes.emplace(articleID, node);
+
+                              return node;
+                          };
+
+        for(size_t i = 0; i < whOrders.size(); ++i)
+        {
+            for(const auto& line : whOrders[i])
+            {
+                int32_t node = lookupNode(line.getArticleID());
+
+                lineNodes[i].push_back(node);
+
+                if(node >= 0)
+                {
+                    orderNodes[i].push_back(node);
+                }
+            }
+
+            std::sort(orderNodes[i].begin(), orderNodes[i].end());
+            orderNodes[i].erase(std::unique(orderNodes[i].begin(), orderNodes[i].end()), orderNodes[i].end());
+        }
+    }
+
+    void WarehouseOrderBatcher_t::calcDistances()
+    {
+        const size_t nodeCount = nodeItemIDs.size();
+
+        distances.assign(nodeCount, nodeCount, 0);
+
+        for(size_t y = 0; y < nodeCount; ++y)
+        {
+            for(size_t x = 0; x < nodeCount; ++x)
+            {
+                if(x == y)
+                {
+                    continue;
+                }
+
+                auto* shortestPath = whPathFinder.getShortestPath(nodeItemIDs[y], nodeItemIDs[x]);
+
+                if(!shortestPath)
+                {
+                    throw std::runtime_error("Batching: no path between locations to visit!");
+                }
+
+                distances(y, x) = whPathFinder.pathDistance(shortestPath->pathToTarget);
+            }
+        }
+    }
+
+    void WarehouseOrderBatcher_t::findOrderNeighbours()
+    {
+        const size_t orderCount = orderNodes.size();
+        const size_t nodeCount = nodeItemIDs.size();
+
+        // How far is each node from the closest location of an order (either direction)
+        WarehouseMatrix_t<int32_t> proximity;
+        proximity.assign(orderCount, nodeCount, std::numeric_limits<int32_t>::max());
+
+        for(size_t i = 0; i < orderCount; ++i)
+        {
+            int32_t* row = proximity.row(i);
+
+            for(int32_t u : orderNodes[i])
+            {
+                for(size_t v = 0; v < nodeCount; ++v)
+                {
+                    row[v] = std::min({ row[v], distances(u, v), distances(v, u) });
+                }
+            }
+        }
+
+        // Mean distance of locations of one order to the other order
+        auto spread = [&](size_t i, size_t j) -> double
+                      {
+                          if(orderNodes[j].empty())
+                          {
+                              return 0.;
+                          }
+
+                          double sum{ 0. };
+
+                          for(int32_t v : orderNodes[j])
+                          {
+                              sum += orderNodes[i].empty() ? 0. : proximity(i, v);
+                          }
+
+                          return sum / orderNodes[j].size();
+                      };
+
+        // Orders visiting each node, orders without any stored location are as close as the ones sharing all
+        std::vector<std::vector<int32_t>> nodeOrders(nodeCount);
+        std::vector<int32_t> emptyOrders;
+
+        for(size_t i = 0; i < orderCount; ++i)
+        {
+            if(orderNodes[i].empty())
+            {
+                emptyOrders.push_back(static_cast<int32_t>(i));
+            }
+
+            for(int32_t u : orderNodes[i])
+            {
+                nodeOrders[u].push_back(static_cast<int32_t>(i));
+            }
+        }
+
+        orderNeighbours.assign(orderCount, std::vector<int32_t>());
+
+        if(neighbourCount == 0)
+        {
+            return;
+        }
+
+        // Equally close orders are resolved in favour of those released at similar time
+        std::vector<std::tuple<double, size_t, int32_t>> candidates;
+        std::vector<size_t> candidateOf(orderCount, orderCount);
+        std::vector<std::pair<int32_t, int32_t>> nodeQueue;
+
+        auto addCandidate = [&](size_t i, size_t j)
+                            {
+                                if(i != j && candidateOf[j] != i)
+                                {
+                                    candidateOf[j] = i;
+                                    candidates.emplace_back(spread(i, j) + spread(j, i), i > j ? i - j : j - i, static_cast<int32_t>(j));
+                                }
+                            };
+
+        auto addAllCandidates = [&](size_t i)
+                                {
+                                    candidates.clear();
+
+                                    for(size_t j = 0; j < orderCount; ++j)
+                                    {
+                                        if(i != j)
+                                        {
+                                            candidates.emplace_back(spread(i, j) + spread(j, i), i > j ? i - j : j - i, static_cast<int32_t>(j));
+                                        }
+                                    }
+                                };
+
+        auto farthestCandidate = [&]() -> double
+                                 {
+                                     std::nth_element(candidates.begin(), candidates.begin() + neighbourCount - 1, candidates.end());
+
+                                     return std::get<0>(candidates[neighbourCount - 1]);
+                                 };
+
+        for(size_t i = 0; i < orderCount; ++i)
+        {
+            candidates.clear();
+
+            for(int32_t j : emptyOrders)
+            {
+                addCandidate(i, j);
+            }
+
+            if(orderNodes[i].empty())
+            {
+                // Every order is equally close, the ones released at similar time win
+                size_t reached{ 0 };
+
+                for(size_t d = 1; reached < neighbourCount && (d <= i || i + d < orderCount); ++d)
+                {
+                    if(d <= i)
+                    {
+                        addCandidate(i, i - d);
+                        ++ reached;
+                    }
+
+                    if(i + d < orderCount)
+                    {
+                        addCandidate(i, i + d);
+                        ++ reached;
+                    }
+                }
+            }
+            else
+            {
+                // Orders are scored when their closest node is reached, starting with the ones sharing a location.
+                // An order not reached yet is at least twice the proximity of the next node away (spread both ways),
+                // so the search stops once it could not replace any of the closest orders. Once half of the orders
+                // were reached, scoring all of them is cheaper than visiting them node by node.
+                size_t visits{ 0 };
+
+                for(int32_t u : orderNodes[i])
+                {
+                    visits += nodeOrders[u].size();
+                }
+
+                if(2 * visits > orderCount)
+                {
+                    addAllCandidates(i);
+                }
+                else
+                {
+                    // The k-th closest score is refreshed whenever candidates doubled, older one is still an upper bound
+                    size_t measured{ 0 };
+                    double farthest{ std::numeric_limits<double>::max() };
+
+                    visits = 0;
+                    nodeQueue.clear();
+
+                    for(size_t v = 0; v < nodeCount; ++v)
+                    {
+                        nodeQueue.emplace_back(proximity(i, v), static_cast<int32_t>(v));
+                    }
+
+                    std::make_heap(nodeQueue.begin(), nodeQueue.end(), std::greater<>());
+
+                    while(!nodeQueue.empty())
+                    {
+                        if(candidates.size() >= neighbourCount && candidates.size() >= 2 * measured)
+                        {
+                            farthest = farthestCandidate();
+                            measured = candidates.size();
+                        }
+
+                        if(farthest < 2. * nodeQueue.front().first)
+                        {
+                            break;
+                        }
+
+                        std::pop_heap(nodeQueue.begin(), nodeQueue.end(), std::greater<>());
+
+                        int32_t v = nodeQueue.back().second;
+                        nodeQueue.pop_back();
+
+                        visits += nodeOrders[v].size();
+
+                        if(2 * visits > orderCount)
+                        {
+                            addAllCandidates(i);
+                            break;
+                        }
+
+                        for(int32_t j : nodeOrders[v])
+                        {
+                            addCandidate(i, j);
+                        }
+                    }
+                }
+            }
+
+            size_t k = std::min(neighbourCount, candidates.size());
+
+            std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+
+            for(size_t c = 0; c < k; ++c)
+            {
+                orderNeighbours[i].push_back(std::get<2>(candidates[c]));
+            }
+        }
+    }
+
+    std::vector<int32_t> WarehouseOrderBatcher_t::route(const std::vector<int32_t>& nodes) const
+    {
+        auto nodeTour = tour::nearestNeighbour(distances, entrance, dispatch, nodes);
+
+        tour::improve(distances, nodeTour);
+
+        return nodeTour;
+    }
+
+    int32_t WarehouseOrderBatcher_t::routeCost(const std::vector<int32_t>& nodes) const
+    {
+        return tour::length(distances, route(nodes));
+    }
+
+    WarehouseOrderBatcher_t::Group_t WarehouseOrderBatcher_t::makeGroup(const std::vector<int32_t>& orders) const
+    {
+        Group_t group;
+        group.orders = orders;
+
+        std::sort(group.orders.begin(), group.orders.end());
+
+        for(int32_t orderIdx : group.orders)
+        {
+            group.nodes = unite(group.nodes, orderNodes[orderIdx]);
+            group.lines += lineNodes[orderIdx].size();
+        }
+
+        // Empty group does not need any tour
+        group.cost = group.orders.empty() ? 0 : routeCost(group.nodes);
+
+        return group;
+    }
+
+    bool WarehouseOrderBatcher_t::fits(size_t orders, size_t lines) const
+    {
+        return orders <= capacity && (maxLines == 0 || orders == 1 || lines <= maxLines);
+    }
+
+    std::vector<int32_t> WarehouseOrderBatcher_t::neighbourGroups(const Group_t& group, size_t self) const
+    {
+        std::vector<int32_t> neighbours;
+
+        for(int32_t orderIdx : group.orders)
+        {
+            for(int32_t neighbour : orderNeighbours[orderIdx])
+            {
+                int32_t g = orderGroup[neighbour];
+
+                if(g >= 0 && static_cast<size_t>(g) != self)
+                {
+                    neighbours.push_back(g);
+                }
+            }
+        }
+
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+        return neighbours;
+    }
+
+    void WarehouseOrderBatcher_t::savingsBatching()
+    {
+        const size_t orderCount = orderNodes.size();
+
+        groups.clear();
+        orderGroup.resize(orderCount);
+
+        for(size_t i = 0; i < orderCount; ++i)
+        {
+            Group_t group;
+            group.orders = { static_cast<int32_t>(i) };
+            group.nodes = orderNodes[i];
+            group.lines = lineNodes[i].size();
+            group.cost = orderCosts[i];
+
+            groups.push_back(std::move(group));
+            orderGroup[i] = static_cast<int32_t>(i);
+        }
+
+        // Saving of merging two groups, stale once either group changes
+        struct Saving_t
+        {
+            int32_t saving;
+            int32_t lhs;
+            int32_t rhs;
+            uint32_t lhsVersion;
+            uint32_t rhsVersion;
+
+            bool operator<(const Saving_t& other) const
+            {
+                return std::tie(saving, other.lhs, other.rhs) < std::tie(other.saving, lhs, rhs);
+            }
+        };
+
+        std::vector<uint32_t> versions(orderCount, 0);
+        std::priority_queue<Saving_t> savings;
+
+        auto pushSavings = [&](int32_t g)
+                           {
+                               for(int32_t n : neighbourGroups(groups[g], g))
+                               {
+                                   const auto& lhs = groups[g];
+                                   const auto& rhs = groups[n];
+
+                                   if(!fits(lhs.orders.size() + rhs.orders.size(), lhs.lines + rhs.lines))
+                                   {
+                                       continue;
+                                   }
+
+                                   int32_t saving = lhs.cost + rhs.cost - routeCost(unite(lhs.nodes, rhs.nodes));
+
+                                   if(saving > 0)
+                                   {
+                                       savings.push(Saving_t{ saving, g, n, versions[g], versions[n] });
+                                   }
+                               }
+                           };
+
+        for(size_t g = 0; g < orderCount; ++g)
+        {
+            pushSavings(static_cast<int32_t>(g));
+        }
+
+        // Greatest saving first, merged group gets new savings with its neighbours
+        while(!savings.empty())
+        {
+            Saving_t s = savings.top();
+            savings.pop();
+
+            if(versions[s.lhs] != s.lhsVersion || versions[s.rhs] != s.rhsVersion)
+            {
+                continue;
+            }
+
+            auto orders = groups[s.lhs].orders;
+            orders.insert(orders.end(), groups[s.rhs].orders.begin(), groups[s.rhs].orders.end());
+
+            groups[s.lhs] = makeGroup(orders);
+            groups[s.rhs] = Group_t();
+
+            ++ versions[s.lhs];
+            ++ versions[s.rhs];
+
+            for(int32_t orderIdx : groups[s.lhs].orders)
+            {
+                orderGroup[orderIdx] = s.lhs;
+            }
+
+            pushSavings(s.lhs);
+        }
+    }
+
+    void WarehouseOrderBatcher_t::seedBatching()
+    {
+        const size_t orderCount = orderNodes.size();
+
+        groups.clear();
+        orderGroup.assign(orderCount, -1);
+
+        // Most remote orders are seeds first, closer orders are added to them
+        std::vector<int32_t> seeds(orderCount);
+        std::iota(seeds.begin(), seeds.end(), 0);
+
+        std::stable_sort(seeds.begin(), seeds.end(),
+                         [this](int32_t lhs, int32_t rhs) -> bool
+                         {
+                             return orderCosts[lhs] > orderCosts[rhs];
+                         });
+
+        for(int32_t seed : seeds)
+        {
+            if(orderGroup[seed] >= 0)
+            {
+                continue;
+            }
+
+            int32_t g = static_cast<int32_t>(groups.size());
+
+            groups.push_back(makeGroup({ seed }));
+            orderGroup[seed] = g;
+
+            for(;;)
+            {
+                const auto& group = groups[g];
+
+                int32_t bestOrder{ -1 };
+                int32_t bestIncrease{ std::numeric_limits<int32_t>::max() };
+
+                for(int32_t orderIdx : group.orders)
+                {
+                    for(int32_t candidate : orderNeighbours[orderIdx])
+                    {
+                        if(orderGroup[candidate] >= 0 || !fits(group.orders.size() + 1, group.lines + lineNodes[candidate].size()))
+                        {
+                            continue;
+                        }
+
+                        int32_t increase = routeCost(unite(group.nodes, orderNodes[candidate])) - group.cost;
+
+                        if(increase < bestIncrease || (increase == bestIncrease && candidate < bestOrder))
+                        {
+                            bestOrder = candidate;
+                            bestIncrease = increase;
+                        }
+                    }
+                }
+
+                if(bestOrder < 0)
+                {
+                    break;
+                }
+
+                auto orders = group.orders;
+                orders.push_back(bestOrder);
+
+                groups[g] = makeGroup(orders);
+                orderGroup[bestOrder] = g;
+            }
+        }
+    }
+
+    void WarehouseOrderBatcher_t::improveBatches()
+    {
+        const size_t orderCount = orderNodes.size();
+
+        auto assign = [this](int32_t g, Group_t&& group)
+                      {
+                          for(int32_t orderIdx : group.orders)
+                          {
+                              orderGroup[orderIdx] = g;
+                          }
+
+                          groups[g] = std::move(group);
+                      };
+
+        bool improved{ true };
+
+        for(int32_t pass = 0; improved && pass < E_MAX_IMPROVE_PASSES; ++pass)
+        {
+            improved = false;
+
+            for(size_t o = 0; o < orderCount; ++o)
+            {
+                const int32_t orderIdx = static_cast<int32_t>(o);
+                const int32_t a = orderGroup[orderIdx];
+
+                Group_t single;
+                single.orders = { orderIdx };
+
+                for(int32_t b : neighbourGroups(single, a))
+                {
+                    const auto& lhs = groups[a];
+                    const auto& rhs = groups[b];
+                    const int32_t current = lhs.cost + rhs.cost;
+
+                    // Move the order to the other batch
+                    if(fits(rhs.orders.size() + 1, rhs.lines + lineNodes[orderIdx].size()))
+                    {
+                        auto rhsOrders = rhs.orders;
+                        rhsOrders.push_back(orderIdx);
+
+                        Group_t newLhs = makeGroup(without(lhs.orders, orderIdx));
+                        Group_t newRhs = makeGroup(rhsOrders);
+
+                        if(newLhs.cost + newRhs.cost < current)
+                        {
+                            assign(a, std::move(newLhs));
+                            assign(b, std::move(newRhs));
+
+                            improved = true;
+                            break;
+                        }
+                    }
+
+                    // Swap it with an order of the other batch
+                    bool swapped{ false };
+
+                    for(int32_t other : rhs.orders)
+                    {
+                        auto lhsOrders = without(lhs.orders, orderIdx);
+                        auto rhsOrders = without(rhs.orders, other);
+
+                        lhsOrders.push_back(other);
+                        rhsOrders.push_back(orderIdx);
+
+                        Group_t newLhs = makeGroup(lhsOrders);
+                        Group_t newRhs = makeGroup(rhsOrders);
+
+                        if(fits(newLhs.orders.size(), newLhs.lines) && fits(newRhs.orders.size(), newRhs.lines) &&
+                           newLhs.cost + newRhs.cost < current)
+                        {
+                            assign(a, std::move(newLhs));
+                            assign(b, std::move(newRhs));
+
+                            swapped = true;
+                            break;
+                        }
+                    }
+
+                    if(swapped)
+                    {
+                        improved = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif
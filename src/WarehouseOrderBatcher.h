@@ -0,0 +1,114 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseOrderBatcher.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Grouping of orders into pick waves sharing one tour
+ */
+
+#pragma once
+
+#ifdef WHM_SIM
+
+// Std
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Local
+#include "ConfigParser.h"
+#include "WarehouseMatrix.h"
+#include "WarehouseOrderBook.h"
+#include "WarehousePathFinder.h"
+
+namespace whm
+{
+    /**
+     * @brief Orders are batched by savings or seed heuristic and batches are improved by moving
+     *        and swapping orders between them
+     *
+     * Each line is picked at the first location holding its article (as normal preprocessing does),
+     * tours start at the entrance and end at the dispatch. Only orders close to each other (similar
+     * locations) are considered for the same batch.
+     */
+    class WarehouseOrderBatcher_t
+    {
+        public:
+            struct PickLine_t
+            {
+                int32_t orderIdx{ 0 };  //< Index into order book
+                int32_t lineIdx{ 0 };   //< Index into lines of the order
+            };
+
+            struct Batch_t
+            {
+                std::vector<int32_t> orders;   //< Indices into order book
+                std::vector<int32_t> tour;     //< Locations in visiting order (warehouse item IDs)
+                int32_t cost{ 0 };             //< Entrance - locations - dispatch [m]
+            };
+
+            WarehouseOrderBatcher_t(const WarehousePathFinder_t&, const ConfigParser_t&);
+
+            const std::vector<Batch_t>& createBatches(const WarehouseOrderBook_t&, int32_t, int32_t);
+
+            /// Lines of a batch in order of its tour
+            std::vector<PickLine_t> getPickLines(const Batch_t&) const;
+
+            int64_t getSingleOrderCost() const;
+            int64_t getBatchedCost() const;
+
+        protected:
+            // Batch under construction (indices of orders and union of their nodes)
+            struct Group_t
+            {
+                std::vector<int32_t> orders;
+                std::vector<int32_t> nodes;
+                size_t lines{ 0 };
+                int32_t cost{ 0 };
+            };
+
+            void findOrderNodes(const WarehouseOrderBook_t&, int32_t, int32_t);
+            void calcDistances();
+            void findOrderNeighbours();
+
+            int32_t routeCost(const std::vector<int32_t>&) const;
+            std::vector<int32_t> route(const std::vector<int32_t>&) const;
+
+            Group_t makeGroup(const std::vector<int32_t>&) const;
+            bool fits(size_t, size_t) const;
+
+            void savingsBatching();
+            void seedBatching();
+            void improveBatches();
+
+            std::vector<int32_t> neighbourGroups(const Group_t&, size_t) const;
+
+        private:
+            const WarehousePathFinder_t& whPathFinder;
+
+            size_t capacity;        //< Orders per batch
+            size_t maxLines;        //< Lines per batch (0 - unlimited)
+            size_t neighbourCount;  //< Orders considered close to each order
+            std::string method;
+            bool localSearch;
+
+            // Nodes are the entrance, the dispatch and the locations of all orders
+            int32_t entrance{ 0 };
+            int32_t dispatch{ 1 };
+            std::vector<int32_t> nodeItemIDs;
+            WarehouseMatrix_t<int32_t> distances;
+
+            std::vector<std::vector<int32_t>> orderNodes;      //< Distinct nodes of each order
+            std::vector<std::vector<int32_t>> lineNodes;       //< Node of each line of each order (-1 if not stored)
+            std::vector<int32_t> orderCosts;                   //< Tour of the order alone
+            std::vector<std::vector<int32_t>> orderNeighbours;
+
+            std::vector<Group_t> groups;
+            std::vector<int32_t> orderGroup;                   //< Group of each order
+
+            std::vector<Batch_t> batches;
+    };
+}
+
+#endif
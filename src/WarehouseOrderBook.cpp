@@ -0,0 +1,424 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseOrderBook.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Compact storage of customer orders (compressed sparse rows of order lines)
+ */
+
+// Std
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+// Unix
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Local
+#include "WarehouseOrder.h"
+#include "WarehouseArticles.h"
+#include "WarehouseOrderBook.h"
+
+namespace whm
+{
+    namespace
+    {
+        constexpr char binaryMagic[4] = { 'W', 'H', 'M', 'O' };
+        constexpr uint32_t binaryVersion = 1;
+        constexpr uint32_t binaryByteOrder = 0x01020304;
+
+        /**
+         * @brief Header of binary order file, all sections are 8 bytes aligned
+         *
+         * Article dictionary consists of (articleCount + 1) uint32 offsets followed by article names,
+         * article IDs of order lines are indices into this dictionary.
+         */
+        struct BinaryHeader_t
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t byteOrder;
+            uint32_t headerSize;
+            uint64_t fileSize;
+            uint64_t orderCount;
+            uint64_t lineCount;
+            uint64_t articleCount;
+            uint64_t dictionaryOffset;
+            uint64_t orderIDsOffset;
+            uint64_t orderTypesOffset;
+            uint64_t offsetsOffset;
+            uint64_t lineIDsOffset;
+            uint64_t articleIDsOffset;
+            uint64_t quantitiesOffset;
+        };
+
+        uint64_t align(uint64_t offset)
+        {
+            return (offset + 7) & ~uint64_t{ 7 };
+        }
+
+        template<typename T>
+        const T* section(const char* base, uint64_t fileSize, uint64_t offset, uint64_t count)
+        {
+            if(offset % alignof(T) || offset > fileSize || count > (fileSize - offset) / sizeof(T))
+            {
+                throw std::runtime_error("Failed to parse orders binary!");
+            }
+
+            return reinterpret_cast<const T*>(base + offset);
+        }
+    }
+
+    const std::string& WarehouseOrderBook_t::Line_t::getArticle() const
+    {
+        return WarehouseArticles_t::getWhArticles().getArticle(getArticleID());
+    }
+
+    void WarehouseOrderBook_t::Line_t::dump() const
+    {
+        std::cout << "    LineID <" << this->getWhLineID()
+                  << "> Article <"  << this->getArticle()
+                  << "> Quantity <" << this->getQuantity()
+                  << ">"            << std::endl;
+    }
+
+    void WarehouseOrderBook_t::Order_t::dump() const
+    {
+        std::cout << "---------------------------------" << std::endl;
+        std::cout << "  OrderID <"   << getWhOrderID()
+                  << "> OrderType <" << to_underlying(getWhOrderType())
+                  << ">" << std::endl;
+
+        for(const auto& whLine : getWhOrderLines())
+        {
+            whLine.dump();
+        }
+    }
+
+    WarehouseOrderBook_t::WarehouseOrderBook_t()
+    {
+        offsets.push_back(0);
+    }
+
+    WarehouseOrderBook_t::~WarehouseOrderBook_t()
+    {
+
+    }
+
+    WarehouseOrderBook_t::Order_t WarehouseOrderBook_t::at(size_t i) const
+    {
+        if(i >= size())
+        {
+            throw std::out_of_range("Order index out of range!");
+        }
+
+        return Order_t(this, i);
+    }
+
+    void WarehouseOrderBook_t::reserve(size_t orderCount, size_t lineCount)
+    {
+        orderIDs.reserve(orderCount);
+        orderTypes.reserve(orderCount);
+        offsets.reserve(orderCount + 1);
+
+        lineIDs.reserve(lineCount);
+        articleIDs.reserve(lineCount);
+        quantities.reserve(lineCount);
+    }
+
+    void WarehouseOrderBook_t::clear()
+    {
+        orderIDs.clear();
+        orderTypes.clear();
+        offsets.clear();
+        offsets.push_back(0);
+
+        lineIDs.clear();
+        articleIDs.clear();
+        quantities.clear();
+
+        mapping.reset();
+    }
+
+    void WarehouseOrderBook_t::addWhOrder(int32_t whOrderID, WarehouseOrderType_t whOrderType)
+    {
+        orderIDs.push_back(whOrderID);
+        orderTypes.push_back(to_underlying(whOrderType));
+        offsets.push_back(offsets.back());
+    }
+
+    void WarehouseOrderBook_t::addWhOrder(const WarehouseOrder_t& whOrder)
+    {
+        addWhOrder(whOrder.getWhOrderID(), whOrder.getWhOrderType());
+
+        for(const auto& whLine : whOrder)
+        {
+            addWhOrderLine(whLine.getWhLineID(), WarehouseArticles_t::getWhArticles().intern(whLine.getArticle()), whLine.getQuantity());
+        }
+    }
+
+    void WarehouseOrderBook_t::addWhOrderLine(int32_t whLineID, int32_t articleID, int32_t quantity)
+    {
+        // Line always belongs to the last added order
+        lineIDs.push_back(whLineID);
+        articleIDs.push_back(articleID);
+        quantities.push_back(quantity);
+
+        offsets.set(offsets.size() - 1, offsets.back() + 1);
+    }
+
+    void WarehouseOrderBook_t::eraseWhOrder(int32_t whOrderID)
+    {
+        for(size_t i = 0; i < size(); ++i)
+        {
+            if(orderIDs[i] != whOrderID)
+            {
+                continue;
+            }
+
+            const uint32_t first = offsets[i];
+            const uint32_t last  = offsets[i + 1];
+            const uint32_t count = last - first;
+
+            lineIDs.erase(first, last);
+            articleIDs.erase(first, last);
+            quantities.erase(first, last);
+
+            orderIDs.erase(i, i + 1);
+            orderTypes.erase(i, i + 1);
+            offsets.erase(i + 1, i + 2);
+
+            for(size_t j = i + 1; j < offsets.size(); ++j)
+            {
+                offsets.set(j, offsets[j] - count);
+            }
+
+            return;
+        }
+    }
+
+    void WarehouseOrderBook_t::setQuantity(size_t lineIdx, int32_t quantity)
+    {
+        quantities.set(lineIdx, quantity);
+    }
+
+    bool WarehouseOrderBook_t::isBinaryFile(const std::string& filename)
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        char magic[sizeof(binaryMagic)]{};
+
+        return stream.read(magic, sizeof(magic)) && std::memcmp(magic, binaryMagic, sizeof(magic)) == 0;
+    }
+
+    void WarehouseOrderBook_t::importBinary(const std::string& filename)
+    {
+        // Orders are appended, mapping can be used directly only by an empty book
+        if(!empty())
+        {
+            WarehouseOrderBook_t mapped;
+            mapped.importBinary(filename);
+
+            for(const auto& whOrder : mapped)
+            {
+                addWhOrder(whOrder.getWhOrderID(), whOrder.getWhOrderType());
+
+                for(const auto& whLine : whOrder)
+                {
+                    addWhOrderLine(whLine.getWhLineID(), whLine.getArticleID(), whLine.getQuantity());
+                }
+            }
+
+            return;
+        }
+
+        int fd = open(filename.c_str(), O_RDONLY);
+        struct stat st{};
+
+        if(fd < 0 || fstat(fd, &st) || static_cast<size_t>(st.st_size) < sizeof(BinaryHeader_t))
+        {
+            if(fd >= 0)
+            {
+                close(fd);
+            }
+
+            throw std::runtime_error("Failed to parse orders binary!");
+        }
+
+        const uint64_t fileSize = st.st_size;
+        void* base = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if(base == MAP_FAILED)
+        {
+            throw std::runtime_error("Failed to map orders binary!");
+        }
+
+        madvise(base, fileSize, MADV_WILLNEED);
+
+        std::shared_ptr<const void> region(base, [fileSize](const void* p) { munmap(const_cast<void*>(p), fileSize); });
+        const char* data = static_cast<const char*>(base);
+
+        const auto& header = *reinterpret_cast<const BinaryHeader_t*>(data);
+
+        if(std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) ||
+           header.version != binaryVersion || header.byteOrder != binaryByteOrder ||
+           header.headerSize != sizeof(BinaryHeader_t) || header.fileSize != fileSize ||
+           header.articleCount > static_cast<uint64_t>(INT32_MAX) || header.lineCount > UINT32_MAX)
+        {
+            throw std::runtime_error("Failed to parse orders binary!");
+        }
+
+        const auto* nameOffsets = section<uint32_t>(data, fileSize, header.dictionaryOffset, header.articleCount + 1);
+        const auto* names = section<char>(data, fileSize, header.dictionaryOffset + (header.articleCount + 1) * sizeof(uint32_t),
+                                          nameOffsets[header.articleCount]);
+
+        const auto* fileOrderIDs   = section<int32_t>(data, fileSize, header.orderIDsOffset, header.orderCount);
+        const auto* fileOrderTypes = section<int32_t>(data, fileSize, header.orderTypesOffset, header.orderCount);
+        const auto* fileOffsets    = section<uint32_t>(data, fileSize, header.offsetsOffset, header.orderCount + 1);
+        const auto* fileLineIDs    = section<int32_t>(data, fileSize, header.lineIDsOffset, header.lineCount);
+        const auto* fileArticleIDs = section<int32_t>(data, fileSize, header.articleIDsOffset, header.lineCount);
+        const auto* fileQuantities = section<int32_t>(data, fileSize, header.quantitiesOffset, header.lineCount);
+
+        if(fileOffsets[0] != 0 || fileOffsets[header.orderCount] != header.lineCount)
+        {
+            throw std::runtime_error("Failed to parse orders binary!");
+        }
+
+        for(uint64_t i = 0; i < header.orderCount; ++i)
+        {
+            if(fileOffsets[i] > fileOffsets[i + 1])
+            {
+                throw std::runtime_error("Failed to parse orders binary!");
+            }
+        }
+
+        // File article IDs are translated only if they differ from the global ones
+        auto& whArticles = WarehouseArticles_t::getWhArticles();
+        std::vector<int32_t> articleMap(header.articleCount);
+        bool identity{ true };
+
+        for(uint64_t i = 0; i < header.articleCount; ++i)
+        {
+            if(nameOffsets[i] > nameOffsets[i + 1])
+            {
+                throw std::runtime_error("Failed to parse orders binary!");
+            }
+
+            articleMap[i] = whArticles.intern(std::string(names + nameOffsets[i], nameOffsets[i + 1] - nameOffsets[i]));
+            identity = identity && articleMap[i] == static_cast<int32_t>(i);
+        }
+
+        for(uint64_t i = 0; i < header.lineCount; ++i)
+        {
+            if(fileArticleIDs[i] < 0 || static_cast<uint64_t>(fileArticleIDs[i]) >= header.articleCount)
+            {
+                throw std::runtime_error("Failed to parse orders binary!");
+            }
+        }
+
+        clear();
+
+        orderIDs.map(fileOrderIDs, header.orderCount);
+        orderTypes.map(fileOrderTypes, header.orderCount);
+        offsets.map(fileOffsets, header.orderCount + 1);
+
+        lineIDs.map(fileLineIDs, header.lineCount);
+        quantities.map(fileQuantities, header.lineCount);
+
+        if(identity)
+        {
+            articleIDs.map(fileArticleIDs, header.lineCount);
+        }
+        else
+        {
+            articleIDs.reserve(header.lineCount);
+
+            for(uint64_t i = 0; i < header.lineCount; ++i)
+            {
+                articleIDs.push_back(articleMap[fileArticleIDs[i]]);
+            }
+        }
+
+        mapping = std::move(region);
+    }
+
+    void WarehouseOrderBook_t::exportBinary(const std::string& filename) const
+    {
+        const auto& whArticles = WarehouseArticles_t::getWhArticles();
+
+        // Dictionary contains only used articles, in order of their first use
+        std::unordered_map<int32_t, int32_t> fileArticleIDs;
+        std::vector<int32_t> lineArticleIDs;
+        std::vector<uint32_t> nameOffsets{ 0 };
+        std::string names;
+
+        lineArticleIDs.reserve(articleIDs.size());
+
+        for(int32_t articleID : articleIDs)
+        {
+            auto [it, inserted] = fileArticleIDs.emplace(articleID, static_cast<int32_t>(fileArticleIDs.size()));
+
+            if(inserted)
+            {
+                names += whArticles.getArticle(articleID);
+                nameOffsets.push_back(names.size());
+            }
+
+            lineArticleIDs.push_back(it->second);
+        }
+
+        BinaryHeader_t header{};
+
+        std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+        header.version          = binaryVersion;
+        header.byteOrder        = binaryByteOrder;
+        header.headerSize       = sizeof(BinaryHeader_t);
+        header.orderCount       = size();
+        header.lineCount        = getLineCount();
+        header.articleCount     = fileArticleIDs.size();
+        header.dictionaryOffset = align(sizeof(BinaryHeader_t));
+        header.orderIDsOffset   = align(header.dictionaryOffset + nameOffsets.size() * sizeof(uint32_t) + names.size());
+        header.orderTypesOffset = align(header.orderIDsOffset + header.orderCount * sizeof(int32_t));
+        header.offsetsOffset    = align(header.orderTypesOffset + header.orderCount * sizeof(int32_t));
+        header.lineIDsOffset    = align(header.offsetsOffset + (header.orderCount + 1) * sizeof(uint32_t));
+        header.articleIDsOffset = align(header.lineIDsOffset + header.lineCount * sizeof(int32_t));
+        header.quantitiesOffset = align(header.articleIDsOffset + header.lineCount * sizeof(int32_t));
+        header.fileSize         = header.quantitiesOffset + header.lineCount * sizeof(int32_t);
+
+        std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+
+        if(!stream.is_open())
+        {
+            throw std::runtime_error("Failed to export orders binary!");
+        }
+
+        auto writeAt = [&](uint64_t offset, const void* bytes, size_t count)
+                       {
+                           static const char padding[8]{};
+
+                           stream.write(padding, offset - stream.tellp());
+                           stream.write(static_cast<const char*>(bytes), count);
+                       };
+
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.dictionaryOffset, nameOffsets.data(), nameOffsets.size() * sizeof(uint32_t));
+        writeAt(header.dictionaryOffset + nameOffsets.size() * sizeof(uint32_t), names.data(), names.size());
+        writeAt(header.orderIDsOffset, orderIDs.begin(), header.orderCount * sizeof(int32_t));
+        writeAt(header.orderTypesOffset, orderTypes.begin(), header.orderCount * sizeof(int32_t));
+        writeAt(header.offsetsOffset, offsets.begin(), (header.orderCount + 1) * sizeof(uint32_t));
+        writeAt(header.lineIDsOffset, lineIDs.begin(), header.lineCount * sizeof(int32_t));
+        writeAt(header.articleIDsOffset, lineArticleIDs.data(), header.lineCount * sizeof(int32_t));
+        writeAt(header.quantitiesOffset, quantities.begin(), header.lineCount * sizeof(int32_t));
+
+        if(!stream)
+        {
+            throw std::runtime_error("Failed to export orders binary!");
+        }
+    }
+}
@@ -0,0 +1,230 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseOrderBook.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Compact storage of customer orders (compressed sparse rows of order lines)
+ */
+
+#pragma once
+
+// Std
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+// Local
+#include "WarehouseTypes.h"
+
+namespace whm
+{
+    class WarehouseOrder_t;
+
+    /**
+     * @brief All orders stored in a few flat arrays
+     *
+     * Lines of i-th order are stored in range <offsets[i], offsets[i + 1]) of the line arrays.
+     * Orders and lines are accessed through lightweight views which only refer to the book.
+     *
+     * Arrays are either owned by the book or refer to a read-only mapping of binary order file,
+     * mapped arrays are copied on the first modification.
+     */
+    class WarehouseOrderBook_t
+    {
+        public:
+            /**
+             * @brief Array which is either owned or refers to external (mapped) memory
+             */
+            template<typename T>
+            class Column_t
+            {
+                public:
+                    Column_t() {}
+                    Column_t(const Column_t& rhs) : storage{ rhs.storage }, mapped{ rhs.mapped }, data{ rhs.data }, count{ rhs.count } { sync(); }
+
+                    Column_t& operator=(const Column_t& rhs)
+                    {
+                        storage = rhs.storage;
+                        mapped  = rhs.mapped;
+                        data    = rhs.data;
+                        count   = rhs.count;
+                        sync();
+                        return *this;
+                    }
+
+                    const T& operator[](size_t i) const { return data[i]; }
+                    const T& back() const               { return data[count - 1]; }
+
+                    const T* begin() const { return data; }
+                    const T* end() const   { return data + count; }
+
+                    size_t size() const { return count; }
+                    bool empty() const  { return count == 0; }
+
+                    void map(const T* data_, size_t count_) { storage.clear(); mapped = true; data = data_; count = count_; }
+
+                    // Modifications, mapped data are copied first
+                    void push_back(const T& v)            { edit(); storage.push_back(v); sync(); }
+                    void set(size_t i, const T& v)        { edit(); storage.at(i) = v; }
+                    void erase(size_t first, size_t last) { edit(); storage.erase(storage.begin() + first, storage.begin() + last); sync(); }
+                    void reserve(size_t n)                { edit(); storage.reserve(n); sync(); }
+                    void clear()                          { storage.clear(); mapped = false; sync(); }
+
+                private:
+                    void edit() { if(mapped) { storage.assign(data, data + count); mapped = false; sync(); } }
+                    void sync() { if(!mapped) { data = storage.data(); count = storage.size(); } }
+
+                    std::vector<T> storage;
+                    bool mapped{ false };
+
+                    const T* data{ nullptr };
+                    size_t count{ 0 };
+            };
+
+            /**
+             * @brief Iterator over views addressed by index, current view is kept inside the iterator
+             */
+            template<typename View_t>
+            class Iterator_t
+            {
+                public:
+                    Iterator_t(const WarehouseOrderBook_t* book, size_t idx) : view{ book, idx } {}
+
+                    const View_t& operator*() const  { return view; }
+                    const View_t* operator->() const { return &view; }
+
+                    Iterator_t& operator++() { ++ view.idx; return *this; }
+
+                    bool operator==(const Iterator_t& rhs) const { return view.idx == rhs.view.idx; }
+                    bool operator!=(const Iterator_t& rhs) const { return view.idx != rhs.view.idx; }
+
+                private:
+                    View_t view;
+            };
+
+            /**
+             * @brief View of one order line
+             */
+            class Line_t
+            {
+                public:
+                    Line_t(const WarehouseOrderBook_t* book_, size_t idx_) : book{ book_ }, idx{ idx_ } {}
+
+                    int32_t getWhLineID() const  { return book->lineIDs[idx]; }
+                    int32_t getArticleID() const { return book->articleIDs[idx]; }
+                    int32_t getQuantity() const  { return book->quantities[idx]; }
+
+                    const std::string& getArticle() const;
+
+                    size_t getIndex() const { return idx; }
+
+                    void dump() const;
+
+                private:
+                    friend class Iterator_t<Line_t>;
+
+                    const WarehouseOrderBook_t* book;
+                    size_t idx;
+            };
+
+            /**
+             * @brief View of a range of order lines
+             */
+            class Lines_t
+            {
+                public:
+                    Lines_t(const WarehouseOrderBook_t* book_, size_t first_, size_t last_) : book{ book_ }, first{ first_ }, last{ last_ } {}
+
+                    Iterator_t<Line_t> begin() const { return Iterator_t<Line_t>(book, first); }
+                    Iterator_t<Line_t> end() const   { return Iterator_t<Line_t>(book, last); }
+
+                    Line_t operator[](size_t i) const { return Line_t(book, first + i); }
+
+                    size_t size() const { return last - first; }
+                    bool empty() const  { return first == last; }
+
+                private:
+                    const WarehouseOrderBook_t* book;
+                    size_t first;
+                    size_t last;
+            };
+
+            /**
+             * @brief View of one order
+             */
+            class Order_t
+            {
+                public:
+                    Order_t(const WarehouseOrderBook_t* book_, size_t idx_) : book{ book_ }, idx{ idx_ } {}
+
+                    int32_t getWhOrderID() const                { return book->orderIDs[idx]; }
+                    WarehouseOrderType_t getWhOrderType() const { return static_cast<WarehouseOrderType_t>(book->orderTypes[idx]); }
+
+                    Lines_t getWhOrderLines() const { return Lines_t(book, book->offsets[idx], book->offsets[idx + 1]); }
+
+                    Iterator_t<Line_t> begin() const { return getWhOrderLines().begin(); }
+                    Iterator_t<Line_t> end() const   { return getWhOrderLines().end(); }
+
+                    size_t getIndex() const { return idx; }
+
+                    void dump() const;
+
+                private:
+                    friend class Iterator_t<Order_t>;
+
+                    const WarehouseOrderBook_t* book;
+                    size_t idx;
+            };
+
+            WarehouseOrderBook_t();
+            ~WarehouseOrderBook_t();
+
+            Iterator_t<Order_t> begin() const { return Iterator_t<Order_t>(this, 0); }
+            Iterator_t<Order_t> end() const   { return Iterator_t<Order_t>(this, size()); }
+
+            Order_t operator[](size_t i) const { return Order_t(this, i); }
+            Order_t at(size_t) const;
+
+            size_t size() const { return orderIDs.size(); }
+            bool empty() const  { return orderIDs.empty(); }
+
+            size_t getLineCount() const { return articleIDs.size(); }
+
+            void reserve(size_t, size_t);
+            void clear();
+
+            void addWhOrder(int32_t, WarehouseOrderType_t);
+            void addWhOrder(const WarehouseOrder_t&);
+            void addWhOrderLine(int32_t, int32_t, int32_t);
+            void eraseWhOrder(int32_t);
+
+            void setQuantity(size_t, int32_t);
+
+            // Binary order file
+            static bool isBinaryFile(const std::string&);
+            void importBinary(const std::string&);
+            void exportBinary(const std::string&) const;
+
+            bool isMapped() const { return mapping != nullptr; }
+
+            const Column_t<uint32_t>& getOffsets() const   { return offsets; }
+            const Column_t<int32_t>& getArticleIDs() const { return articleIDs; }
+            const Column_t<int32_t>& getQuantities() const { return quantities; }
+
+        private:
+            // Per order
+            Column_t<int32_t> orderIDs;
+            Column_t<int32_t> orderTypes;
+            Column_t<uint32_t> offsets;
+
+            // Per line
+            Column_t<int32_t> lineIDs;
+            Column_t<int32_t> articleIDs;
+            Column_t<int32_t> quantities;
+
+            // Mapped binary order file, shared by copies of the book
+            std::shared_ptr<const void> mapping;
+    };
+}
@@ -0,0 +1,482 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseOrderParser.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Streaming (SAX-like) parser of customer orders XML
+ */
+
+// Std
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <charconv>
+#include <algorithm>
+#include <stdexcept>
+
+// Local
+#include "WarehouseOrderParser.h"
+
+namespace whm
+{
+    namespace
+    {
+        constexpr std::string_view whitespace = " \t\r\n";
+
+        std::string_view elementName(std::string_view tag)
+        {
+            return tag.substr(0, tag.find_first_of(" \t\r\n/"));
+        }
+
+        struct Markup_t
+        {
+            std::string_view open;   //< Without the leading '<'
+            std::string_view close;
+        };
+
+        /// Comment or CDATA section opened by '<' in front of given position, empty if there is none
+        Markup_t markupAt(std::string_view xml, size_t pos)
+        {
+            constexpr std::string_view commentStart = "!--";
+            constexpr std::string_view cdataStart = "![CDATA[";
+
+            if(xml.compare(pos, commentStart.size(), commentStart) == 0)
+            {
+                return Markup_t{ commentStart, "-->" };
+            }
+            else if(xml.compare(pos, cdataStart.size(), cdataStart) == 0)
+            {
+                return Markup_t{ cdataStart, "]]>" };
+            }
+
+            return Markup_t{};
+        }
+
+        /// End of comment or CDATA section starting at given position, npos if there is none
+        size_t markupEnd(std::string_view xml, size_t pos)
+        {
+            Markup_t markup = markupAt(xml, pos + 1);
+
+            if(markup.open.empty())
+            {
+                return std::string_view::npos;
+            }
+
+            size_t end = xml.find(markup.close, pos + 1 + markup.open.size());
+
+            return end == std::string_view::npos ? xml.size() : end + markup.close.size();
+        }
+
+        /// Start of the first order at or after given position (not an order line, nor one commented out),
+        /// xml is scanned from a position outside of any markup (start of the file or of an order)
+        size_t findOrderStart(std::string_view xml, size_t scanFrom, size_t from)
+        {
+            constexpr std::string_view orderTag = "<WarehouseOrder";
+
+            // Comment or CDATA section in front of the position may reach beyond it
+            for(size_t pos = xml.find("<!", scanFrom); pos < from; pos = xml.find("<!", pos))
+            {
+                size_t end = markupEnd(xml, pos);
+
+                if(end == std::string_view::npos)
+                {
+                    pos += 2;
+                    continue;
+                }
+
+                from = std::max(from, end);
+                pos = end;
+            }
+
+            for(size_t pos = xml.find('<', from); pos != std::string_view::npos; pos = xml.find('<', pos + 1))
+            {
+                size_t end = markupEnd(xml, pos);
+
+                if(end != std::string_view::npos)
+                {
+                    pos = end - 1;
+                    continue;
+                }
+
+                size_t next = pos + orderTag.size();
+
+                if(xml.compare(pos, orderTag.size(), orderTag) == 0 &&
+                   next < xml.size() && std::string_view(" \t\r\n/>").find(xml[next]) != std::string_view::npos)
+                {
+                    return pos;
+                }
+            }
+
+            return xml.size();
+        }
+
+        void appendUtf8(std::string& out, uint32_t code)
+        {
+            if(code < 0x80)
+            {
+                out.push_back(static_cast<char>(code));
+            }
+            else if(code < 0x800)
+            {
+                out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else if(code < 0x10000)
+            {
+                out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else
+            {
+                out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+        }
+    }
+
+    WarehouseOrderParser_t::WarehouseOrderParser_t(OrderCallback_t orderCallback_, LineCallback_t lineCallback_)
+        : orderCallback{ orderCallback_ }
+        , lineCallback{ lineCallback_ }
+    {
+
+    }
+
+    WarehouseOrderParser_t::~WarehouseOrderParser_t()
+    {
+
+    }
+
+    void WarehouseOrderParser_t::parseFile(const std::string& xmlFilename)
+    {
+        std::ifstream xmlStream(xmlFilename, std::ios::binary);
+
+        if(!xmlStream.is_open())
+        {
+            throw std::runtime_error("Failed to parse orders XML!");
+        }
+
+        std::vector<char> chunk(E_CHUNK_SIZE);
+
+        while(xmlStream.read(chunk.data(), chunk.size()) || xmlStream.gcount() > 0)
+        {
+            feed(chunk.data(), xmlStream.gcount());
+        }
+
+        finish();
+    }
+
+    void WarehouseOrderParser_t::feed(const char* data, size_t size)
+    {
+        const char* pos = data;
+        const char* end = data + size;
+
+        while(pos < end)
+        {
+            if(!insideTag)
+            {
+                pos = static_cast<const char*>(std::memchr(pos, '<', end - pos));
+
+                if(!pos)
+                {
+                    return;
+                }
+
+                ++pos;
+                insideTag = true;
+                pendingTag.clear();
+            }
+
+            const char* close = static_cast<const char*>(std::memchr(pos, '>', end - pos));
+
+            if(!close)
+            {
+                pendingTag.append(pos, end);
+                return;
+            }
+
+            std::string_view tag;
+
+            if(pendingTag.empty())
+            {
+                tag = std::string_view(pos, close - pos);
+            }
+            else
+            {
+                pendingTag.append(pos, close);
+                tag = pendingTag;
+            }
+
+            pos = close + 1;
+
+            // '>' inside of a comment, CDATA section or attribute value does not end the tag
+            if(!isComplete(tag))
+            {
+                if(pendingTag.empty())
+                {
+                    pendingTag.assign(tag);
+                }
+
+                pendingTag.push_back('>');
+                continue;
+            }
+
+            insideTag = false;
+            processTag(tag);
+        }
+    }
+
+    void WarehouseOrderParser_t::finish()
+    {
+        bool complete = !insideTag && !orderOpen;
+
+        insideTag = false;
+        orderOpen = false;
+        pendingTag.clear();
+
+        if(!complete)
+        {
+            throw std::runtime_error("Failed to parse orders XML!");
+        }
+    }
+
+    std::vector<std::string_view> WarehouseOrderParser_t::splitChunks(std::string_view xml, size_t count)
+    {
+        std::vector<std::string_view> chunks;
+        size_t begin{ 0 };
+
+        // Chunks are split only in front of an order, so each one can be parsed on its own
+        for(size_t i = 1; i <= count && begin < xml.size(); ++i)
+        {
+            size_t end = i == count ? xml.size() : findOrderStart(xml, begin, std::max(begin + 1, xml.size() / count * i));
+
+            chunks.push_back(xml.substr(begin, end - begin));
+            begin = end;
+        }
+
+        return chunks;
+    }
+
+    bool WarehouseOrderParser_t::isComplete(std::string_view tag) const
+    {
+        // Same sections as skipped by the chunk splitter, their content is not parsed
+        Markup_t markup = markupAt(tag, 0);
+
+        if(!markup.open.empty())
+        {
+            // Tag ends in front of '>', which closes the section too
+            std::string_view close = markup.close.substr(0, markup.close.size() - 1);
+
+            return tag.size() >= markup.open.size() + close.size() && tag.substr(tag.size() - close.size()) == close;
+        }
+
+        char quote{ 0 };
+
+        for(char c : tag)
+        {
+            if(quote)
+            {
+                quote = c == quote ? 0 : quote;
+            }
+            else if(c == '"' || c == '\'')
+            {
+                quote = c;
+            }
+        }
+
+        return quote == 0;
+    }
+
+    void WarehouseOrderParser_t::processTag(std::string_view tag)
+    {
+        if(tag.empty())
+        {
+            throw std::runtime_error("Failed to parse orders XML!");
+        }
+
+        // Declarations, comments and processing instructions
+        if(tag.front() == '?' || tag.front() == '!')
+        {
+            return;
+        }
+
+        if(tag.front() == '/')
+        {
+            if(elementName(tag.substr(1)) == "WarehouseOrder")
+            {
+                if(!orderOpen)
+                {
+                    throw std::runtime_error("Failed to parse orders XML!");
+                }
+
+                orderOpen = false;
+            }
+
+            return;
+        }
+
+        auto name = elementName(tag);
+
+        if(name == "WarehouseOrder")
+        {
+            if(orderOpen)
+            {
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+
+            processOrder(tag);
+            orderOpen = tag.back() != '/';
+        }
+        else if(name == "WarehouseOrderLine")
+        {
+            if(!orderOpen)
+            {
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+
+            processLine(tag);
+        }
+    }
+
+    void WarehouseOrderParser_t::processOrder(std::string_view tag)
+    {
+        orderCallback(intAttribute(tag, "id"), static_cast<WarehouseOrderType_t>(intAttribute(tag, "type")));
+    }
+
+    void WarehouseOrderParser_t::processLine(std::string_view tag)
+    {
+        std::string_view article;
+
+        if(!lookupAttribute(tag, "article_name", article))
+        {
+            throw std::runtime_error("Failed to parse orders XML!");
+        }
+
+        lineCallback(intAttribute(tag, "id"), decodeEntities(article), intAttribute(tag, "requested_quantity"));
+    }
+
+    bool WarehouseOrderParser_t::lookupAttribute(std::string_view tag, std::string_view name, std::string_view& value) const
+    {
+        size_t pos = elementName(tag).size();
+
+        while(pos < tag.size())
+        {
+            pos = tag.find_first_not_of(whitespace, pos);
+
+            if(pos == std::string_view::npos || tag[pos] == '/')
+            {
+                return false;
+            }
+
+            size_t eq = tag.find('=', pos);
+
+            if(eq == std::string_view::npos)
+            {
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+
+            auto attrName = tag.substr(pos, eq - pos);
+            attrName = attrName.substr(0, attrName.find_last_not_of(whitespace) + 1);
+
+            size_t open = tag.find_first_not_of(whitespace, eq + 1);
+
+            if(open == std::string_view::npos || (tag[open] != '"' && tag[open] != '\''))
+            {
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+
+            size_t close = tag.find(tag[open], open + 1);
+
+            if(close == std::string_view::npos)
+            {
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+
+            if(attrName == name)
+            {
+                value = tag.substr(open + 1, close - open - 1);
+                return true;
+            }
+
+            pos = close + 1;
+        }
+
+        return false;
+    }
+
+    int32_t WarehouseOrderParser_t::intAttribute(std::string_view tag, std::string_view name) const
+    {
+        std::string_view value;
+        int32_t result{ 0 };
+
+        // Missing attribute is zero, same as tinyxml2 IntAttribute
+        if(lookupAttribute(tag, name, value))
+        {
+            value = value.substr(std::min(value.find_first_not_of(whitespace), value.size()));
+
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+
+            if(ec != std::errc())
+            {
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+        }
+
+        return result;
+    }
+
+    std::string_view WarehouseOrderParser_t::decodeEntities(std::string_view value)
+    {
+        if(value.find('&') == std::string_view::npos)
+        {
+            return value;
+        }
+
+        decoded.clear();
+
+        for(size_t i = 0; i < value.size(); ++i)
+        {
+            size_t semicolon = value[i] == '&' ? value.find(';', i) : std::string_view::npos;
+
+            if(semicolon == std::string_view::npos)
+            {
+                decoded.push_back(value[i]);
+                continue;
+            }
+
+            auto entity = value.substr(i + 1, semicolon - i - 1);
+
+            if(entity == "amp")       decoded.push_back('&');
+            else if(entity == "lt")   decoded.push_back('<');
+            else if(entity == "gt")   decoded.push_back('>');
+            else if(entity == "quot") decoded.push_back('"');
+            else if(entity == "apos") decoded.push_back('\'');
+            else if(entity.size() > 1 && entity.front() == '#')
+            {
+                bool hex = entity[1] == 'x' || entity[1] == 'X';
+                uint32_t code{ 0 };
+
+                auto digits = entity.substr(hex ? 2 : 1);
+                auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), code, hex ? 16 : 10);
+
+                if(ec != std::errc() || ptr != digits.data() + digits.size())
+                {
+                    throw std::runtime_error("Failed to parse orders XML!");
+                }
+
+                appendUtf8(decoded, code);
+            }
+            else
+            {
+                throw std::runtime_error("Failed to parse orders XML!");
+            }
+
+            i = semicolon;
+        }
+
+        return decoded;
+    }
+}
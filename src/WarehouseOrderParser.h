@@ -0,0 +1,69 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseOrderParser.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Streaming (SAX-like) parser of customer orders XML
+ */
+
+#pragma once
+
+// Std
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+// Local
+#include "WarehouseTypes.h"
+
+namespace whm
+{
+    /**
+     * @brief Parses orders XML incrementally and reports orders and lines through callbacks
+     *
+     * Input may be fed in arbitrary pieces, only a tag split between two pieces is buffered,
+     * so memory used by the parser does not depend on the size of the file.
+     */
+    class WarehouseOrderParser_t
+    {
+        public:
+            using OrderCallback_t = std::function<void(int32_t, WarehouseOrderType_t)>;
+            using LineCallback_t  = std::function<void(int32_t, std::string_view, int32_t)>;
+
+            static constexpr size_t E_CHUNK_SIZE = 1 << 16;
+            static constexpr size_t E_MIN_PARALLEL_CHUNK_SIZE = 1 << 20;
+
+            WarehouseOrderParser_t(OrderCallback_t, LineCallback_t);
+            ~WarehouseOrderParser_t();
+
+            void parseFile(const std::string&);
+
+            void feed(const char*, size_t);
+            void finish();
+
+            static std::vector<std::string_view> splitChunks(std::string_view, size_t);
+
+        protected:
+            bool isComplete(std::string_view) const;
+            void processTag(std::string_view);
+            void processOrder(std::string_view);
+            void processLine(std::string_view);
+
+            bool lookupAttribute(std::string_view, std::string_view, std::string_view&) const;
+            int32_t intAttribute(std::string_view, std::string_view) const;
+            std::string_view decodeEntities(std::string_view);
+
+        private:
+            OrderCallback_t orderCallback;
+            LineCallback_t lineCallback;
+
+            bool insideTag{ false }; //< Last piece ended inside of a tag
+            bool orderOpen{ false }; //< Lines belong to this order until its end tag
+
+            std::string pendingTag;  //< Part of a tag from the previous piece(s)
+            std::string decoded;     //< Attribute value with entities replaced
+    };
+}
@@ -8,15 +8,17 @@
  */
 
 
+#include <queue>
+#include <limits>
+#include <unordered_set>
 #include <iostream>
+#include <numeric>
 #include <iterator>
 #include <algorithm>
+#include <functional>
 
 #include "Logger.h"
-#include "WarehousePort.h"
-#include "WarehouseItem.h"
-#include "WarehouseLayout.h"
-#include "WarehouseConnection.h"
+#include "WarehouseLayoutGraph.h"
 #include "WarehousePathFinder.h"
 
 template <typename T>
@@ -34,7 +36,44 @@ std::ostream& operator<<(std::ostream& out, const std::vector<std::pair<T, T>>&
 
 namespace whm
 {
+    namespace
+    {
+        /// SplitMix64 finalizer
+        uint64_t mix(uint64_t z)
+        {
+            z += 0x9e3779b97f4a7c15ULL;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+            return z ^ (z >> 31);
+        }
+
+        /// Hash of path lengths from one source, addition does not depend on order of the table
+        uint64_t sourceFingerprint(int32_t sourceItemID, const std::vector<WarehousePathInfo_t>& sourcePaths)
+        {
+            uint64_t hash{ 0 };
+
+            for(const auto& pathInfo : sourcePaths)
+            {
+                int64_t distance{ 0 };
+
+                for(const auto& pathItem : pathInfo.pathToTarget)
+                {
+                    distance += pathItem.second;
+                }
+
+                uint64_t path = (static_cast<uint64_t>(static_cast<uint32_t>(sourceItemID)) << 32) |
+                                 static_cast<uint32_t>(pathInfo.targetWhItemID);
+
+                hash += mix(mix(path) ^ static_cast<uint64_t>(distance));
+            }
+
+            return hash;
+        }
+    }
+
     WarehousePathFinder_t::WarehousePathFinder_t()
+        : whPaths{ std::make_shared<WarehousePaths_t>() }
     {
 
     }
@@ -46,112 +85,378 @@ namespace whm
 
     void WarehousePathFinder_t::clearPrecalculatedPaths()
     {
-        whPaths.clear();
+        whPaths = std::make_shared<WarehousePaths_t>();
+        pathsGraph.reset();
+        pathsFingerprint = 0;
+    }
+
+    void WarehousePathFinder_t::precalculatePaths(const WarehouseLayoutGraph_t& whGraph)
+    {
+        whPaths = std::make_shared<WarehousePaths_t>();
+        pathsGraph = std::make_shared<const WarehouseLayoutGraph_t>(whGraph);
+        pathsFingerprint = 0;
+
+        for(uint32_t node = 0; node < whGraph.getNodeCount(); ++node)
+        {
+            if(!whGraph.isConveyor(node))
+            {
+                this->precalculatePaths(whGraph, node);
+            }
+        }
     }
 
-    void WarehousePathFinder_t::precalculatePaths(const std::vector<WarehouseItem_t*>& whItems)
+    void WarehousePathFinder_t::updatePaths(const WarehouseLayoutGraph_t& whGraph)
     {
-        std::for_each(whItems.begin(), whItems.end(),
-                      [&](const WarehouseItem_t* whItem)
-                      {
-                          if(whItem->getType() != WarehouseItemType_t::E_CONVEYOR &&
-                             whItem->getType() != WarehouseItemType_t::E_CONVEYOR_HUB)
-                          {
-                            this->precalculatePaths(whItem->getWhItemID(), whItem, WarehousePathInfo_t{});
-                          }
-                      });
+        if(!pathsGraph)
+        {
+            this->precalculatePaths(whGraph);
+            return;
+        }
 
-        std::unordered_map<int32_t, std::vector<WarehousePathInfo_t>> whPathsFiltered;
+        const WarehouseLayoutGraph_t& oldGraph = *pathsGraph;
 
-        for(auto* whItemLhs : whItems)
+        // Edge leaving a conveyor, taken in the old graph (removed edge) or in the new one (inserted edge)
+        struct EdgeChange_t
         {
-            if(whItemLhs->getType() != WarehouseItemType_t::E_CONVEYOR &&
-               whItemLhs->getType() != WarehouseItemType_t::E_CONVEYOR_HUB)
+            uint32_t from;  //< Node of the old graph
+            int32_t to;     //< Node of the old graph, E_NO_NODE if the item is new
+            int32_t cost;
+        };
+
+        std::vector<EdgeChange_t> edgeChanges;
+        std::unordered_set<int32_t> affectedSources;
+
+        auto edgeCost = [](const WarehouseLayoutGraph_t& g, const WarehouseLayoutGraph_t::Edge_t& edge)
+                        {
+                            return g.isConveyor(edge.to) ? edge.length : 0;
+                        };
+
+        // Item which was added, removed or has different length or type
+        auto nodeChanged = [&](int32_t whItemID) -> bool
+                           {
+                               int32_t oldNode = oldGraph.getNodeIndex(whItemID);
+                               int32_t newNode = whGraph.getNodeIndex(whItemID);
+
+                               return oldNode == WarehouseLayoutGraph_t::E_NO_NODE || newNode == WarehouseLayoutGraph_t::E_NO_NODE ||
+                                      oldGraph.getLength(oldNode) != whGraph.getLength(newNode) ||
+                                      oldGraph.getFlags(oldNode) != whGraph.getFlags(newNode);
+                           };
+
+        // Order of edges matters when equally long paths are resolved, reordered edges are replaced as a whole
+        auto edgesChanged = [&](int32_t whItemID) -> bool
+                            {
+                                auto oldEdges = oldGraph.getEdges(oldGraph.getNodeIndex(whItemID));
+                                auto newEdges = whGraph.getEdges(whGraph.getNodeIndex(whItemID));
+
+                                return !std::equal(oldEdges.begin(), oldEdges.end(), newEdges.begin(), newEdges.end(),
+                                                   [&](const auto& oldEdge, const auto& newEdge)
+                                                   {
+                                                       return oldGraph.getWhItemID(oldEdge.to) == whGraph.getWhItemID(newEdge.to);
+                                                   });
+                            };
+
+        // Removed edges
+        for(uint32_t node = 0; node < oldGraph.getNodeCount(); ++node)
+        {
+            int32_t whItemID = oldGraph.getWhItemID(node);
+            bool allEdges = nodeChanged(whItemID) || edgesChanged(whItemID);
+
+            if(allEdges && !oldGraph.isConveyor(node))
             {
-                for(auto* whItemRhs : whItems)
+                affectedSources.insert(whItemID);
+            }
+
+            for(const auto& edge : oldGraph.getEdges(node))
+            {
+                if(allEdges || nodeChanged(oldGraph.getWhItemID(edge.to)))
                 {
-                    if(whItemRhs->getType() != WarehouseItemType_t::E_CONVEYOR &&
-                       whItemRhs->getType() != WarehouseItemType_t::E_CONVEYOR_HUB)
+                    if(!oldGraph.isConveyor(node))
                     {
-                        auto* shortestPath = getShortestPath(whItemLhs->getWhItemID(), whItemRhs->getWhItemID());
-
-                        if(shortestPath)
-                        {
-                            whPathsFiltered[whItemLhs->getWhItemID()].push_back(*shortestPath);
-                        }
-                        else
-                        {
-                            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Failed to filter paths");
-                        }
+                        affectedSources.insert(whItemID);
+                    }
+                    else
+                    {
+                        edgeChanges.push_back(EdgeChange_t{ node, static_cast<int32_t>(edge.to), edgeCost(oldGraph, edge) });
                     }
                 }
             }
         }
 
-        whPaths = std::move(whPathsFiltered);
-    }
+        // Inserted edges, the ones leaving changed conveyors are covered by edges entering them
+        for(uint32_t node = 0; node < whGraph.getNodeCount(); ++node)
+        {
+            int32_t whItemID = whGraph.getWhItemID(node);
+            bool changed = nodeChanged(whItemID);
+            bool allEdges = changed || edgesChanged(whItemID);
 
-    void WarehousePathFinder_t::precalculatePaths(int32_t sourceWhItemID, const WarehouseItem_t* whItem, WarehousePathInfo_t pathInfo)
-    {
-        auto whItemID = whItem->getWhItemID();
-        auto it = std::find_if(pathInfo.pathToTarget.begin(), pathInfo.pathToTarget.end(),
-                               [&whItemID](auto& pathItem) -> bool
-                               {
-                                   return pathItem.first == whItemID;
-                               });
+            if(allEdges && !whGraph.isConveyor(node))
+            {
+                affectedSources.insert(whItemID);
+            }
 
-        if(it != pathInfo.pathToTarget.end())
+            if(changed)
+            {
+                continue;
+            }
+
+            for(const auto& edge : whGraph.getEdges(node))
+            {
+                if(!allEdges && !nodeChanged(whGraph.getWhItemID(edge.to)))
+                {
+                    continue;
+                }
+
+                if(!whGraph.isConveyor(node))
+                {
+                    affectedSources.insert(whItemID);
+                }
+                else
+                {
+                    edgeChanges.push_back(EdgeChange_t{ static_cast<uint32_t>(oldGraph.getNodeIndex(whItemID)),
+                                                        oldGraph.getNodeIndex(whGraph.getWhItemID(edge.to)),
+                                                        edgeCost(whGraph, edge) });
+                }
+            }
+        }
+
+        std::unordered_set<uint32_t> searchedNodes;
+        size_t sourceCount{ 0 };
+
+        for(const auto& edgeChange : edgeChanges)
+        {
+            searchedNodes.insert(edgeChange.from);
+
+            if(edgeChange.to != WarehouseLayoutGraph_t::E_NO_NODE)
+            {
+                searchedNodes.insert(edgeChange.to);
+            }
+        }
+
+        for(uint32_t node = 0; node < whGraph.getNodeCount(); ++node)
         {
-            // Loop detected, abort.
+            sourceCount += !whGraph.isConveyor(node);
+        }
+
+        // Searching from changed edges would cost more than recalculating everything
+        if(searchedNodes.size() + affectedSources.size() >= sourceCount)
+        {
+            this->precalculatePaths(whGraph);
             return;
         }
 
-        // Add new item to the map in case its not conv
-        if(whItem->getType() != WarehouseItemType_t::E_CONVEYOR &&
-           whItem->getType() != WarehouseItemType_t::E_CONVEYOR_HUB)
+        // Incoming edges of old graph (compressed sparse rows)
+        std::vector<uint32_t> inOffsets(oldGraph.getNodeCount() + 1, 0);
+        std::vector<uint32_t> inEdges(oldGraph.getEdgeCount());
+
+        for(uint32_t node = 0; node < oldGraph.getNodeCount(); ++node)
+        {
+            for(const auto& edge : oldGraph.getEdges(node))
+            {
+                ++ inOffsets[edge.to + 1];
+            }
+        }
+
+        std::partial_sum(inOffsets.begin(), inOffsets.end(), inOffsets.begin());
+
+        std::vector<uint32_t> inFill(inOffsets.begin(), inOffsets.end() - 1);
+
+        for(uint32_t node = 0; node < oldGraph.getNodeCount(); ++node)
+        {
+            for(const auto& edge : oldGraph.getEdges(node))
+            {
+                inEdges[inFill[edge.to]++] = node;
+            }
+        }
+
+        std::unordered_map<uint32_t, std::vector<int32_t>> distancesTo;
+
+        for(uint32_t node : searchedNodes)
+        {
+            distancesTo.emplace(node, this->reverseDistances(inOffsets, inEdges, node));
+        }
+
+        // Source may take the changed edge if it is not longer than its current path to the edge's end
+        constexpr int32_t unreachable = std::numeric_limits<int32_t>::max();
+
+        for(const auto& edgeChange : edgeChanges)
+        {
+            const auto& fromDistances = distancesTo.at(edgeChange.from);
+            const auto* toDistances = edgeChange.to != WarehouseLayoutGraph_t::E_NO_NODE ? &distancesTo.at(edgeChange.to) : nullptr;
+
+            for(uint32_t source = 0; source < oldGraph.getNodeCount(); ++source)
+            {
+                if(oldGraph.isConveyor(source) || fromDistances[source] == unreachable)
+                {
+                    continue;
+                }
+
+                if(!toDistances || (*toDistances)[source] == unreachable || fromDistances[source] + edgeChange.cost <= (*toDistances)[source])
+                {
+                    affectedSources.insert(oldGraph.getWhItemID(source));
+                }
+            }
+        }
+
+        if(whPaths.use_count() > 1)
+        {
+            whPaths = std::make_shared<WarehousePaths_t>(*whPaths);
+        }
+
+        pathsGraph = std::make_shared<const WarehouseLayoutGraph_t>(whGraph);
+
+        for(int32_t whItemID : affectedSources)
+        {
+            int32_t node = whGraph.getNodeIndex(whItemID);
+
+            if(node == WarehouseLayoutGraph_t::E_NO_NODE || whGraph.isConveyor(node))
+            {
+                auto it = whPaths->find(whItemID);
+
+                if(it != whPaths->end())
+                {
+                    pathsFingerprint -= sourceFingerprint(it->first, it->second);
+                    whPaths->erase(it);
+                }
+            }
+            else
+            {
+                this->precalculatePaths(whGraph, node);
+            }
+        }
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "Paths updated: <%zu> changed edges, <%zu> of <%zu> sources recalculated",
+                                    edgeChanges.size(), affectedSources.size(), sourceCount);
+    }
+
+    std::vector<int32_t> WarehousePathFinder_t::reverseDistances(const std::vector<uint32_t>& inOffsets, const std::vector<uint32_t>& inEdges, uint32_t target) const
+    {
+        const WarehouseLayoutGraph_t& whGraph = *pathsGraph;
+
+        using QueueItem_t = std::pair<int32_t, uint32_t>;
+
+        std::vector<int32_t> distances(whGraph.getNodeCount(), std::numeric_limits<int32_t>::max());
+        std::priority_queue<QueueItem_t, std::vector<QueueItem_t>, std::greater<QueueItem_t>> queue;
+
+        distances[target] = 0;
+        queue.emplace(0, target);
+
+        // Same as precalculation against edge direction, path can start but not pass through non-conv item
+        while(!queue.empty())
         {
-            pathInfo.targetWhItemID = whItemID;
-            whPaths[sourceWhItemID].push_back(pathInfo);
-            if(sourceWhItemID != whItemID)
+            auto [distance, node] = queue.top();
+            queue.pop();
+
+            if(distance > distances[node] || (node != target && !whGraph.isConveyor(node)))
             {
-                return;
+                continue;
+            }
+
+            int32_t newDistance = distance + (whGraph.isConveyor(node) ? whGraph.getLength(node) : 0);
+
+            for(uint32_t inIdx = inOffsets[node]; inIdx < inOffsets[node + 1]; ++inIdx)
+            {
+                uint32_t from = inEdges[inIdx];
+
+                if(newDistance < distances[from])
+                {
+                    distances[from] = newDistance;
+                    queue.emplace(newDistance, from);
+                }
             }
         }
 
-        // Update path info attributes
-        if(sourceWhItemID != whItemID)
+        return distances;
+    }
+
+    void WarehousePathFinder_t::sharePaths(const WarehousePathFinder_t& other)
+    {
+        whPaths = other.whPaths;
+        pathsGraph = other.pathsGraph;
+        pathsFingerprint = other.pathsFingerprint;
+    }
+
+    void WarehousePathFinder_t::precalculatePaths(const WarehouseLayoutGraph_t& whGraph, uint32_t source)
+    {
+        constexpr int32_t unreachable = std::numeric_limits<int32_t>::max();
+        constexpr uint32_t noPredecessor = std::numeric_limits<uint32_t>::max();
+
+        using QueueItem_t = std::pair<int32_t, uint32_t>;
+
+        std::vector<int32_t> distances(whGraph.getNodeCount(), unreachable);
+        std::vector<uint32_t> predecessors(whGraph.getNodeCount(), noPredecessor);
+        std::vector<uint32_t> hops(whGraph.getNodeCount(), 0);
+        std::priority_queue<QueueItem_t, std::vector<QueueItem_t>, std::greater<QueueItem_t>> queue;
+
+        distances[source] = 0;
+        queue.emplace(0, source);
+
+        // Dijkstra, only conveyors are passed through, other items terminate the path
+        while(!queue.empty())
         {
-            pathInfo.pathToTarget.emplace_back(std::make_pair(whItemID, whItem->getW() / WarehouseLayout_t::getWhLayout().getRatio()));
+            auto [distance, node] = queue.top();
+            queue.pop();
+
+            if(distance > distances[node] || (node != source && !whGraph.isConveyor(node)))
+            {
+                continue;
+            }
+
+            for(const auto& edge : whGraph.getEdges(node))
+            {
+                int32_t newDistance = distance + (whGraph.isConveyor(edge.to) ? edge.length : 0);
+
+                if(newDistance < distances[edge.to])
+                {
+                    distances[edge.to] = newDistance;
+                    predecessors[edge.to] = node;
+                    hops[edge.to] = hops[node] + 1;
+                    queue.emplace(newDistance, edge.to);
+                }
+                else if(newDistance == distances[edge.to] && edge.to != source && hops[node] + 1 < hops[edge.to])
+                {
+                    // Equally long paths are resolved in favour of fewer items, then of the first one found
+                    predecessors[edge.to] = node;
+                    hops[edge.to] = hops[node] + 1;
+                }
+            }
         }
 
-        // Recursively call for each connected port
-        const auto& whPorts = whItem->getWhPorts();
-        std::for_each(whPorts.begin(), whPorts.end(),
-                      [&](const auto* whPort)
-                      {
-                          if(whPort->isConnected())
-                          {
-                              const auto* whConn = whPort->getWhConn();
+        // Path to each reachable non-conv item consists of the conveyors in between
+        int32_t sourceItemID = whGraph.getWhItemID(source);
+        auto& sourcePaths = (*whPaths)[sourceItemID];
 
-                              if (whConn->getTo()->getWhItem()->getWhItemID() != sourceWhItemID)
-                              {
-                                  precalculatePaths(sourceWhItemID, whConn->getTo()->getWhItem(), pathInfo);
-                              }
-                              if (whConn->getFrom()->getWhItem()->getWhItemID() != sourceWhItemID)
-                              {
-                                  precalculatePaths(sourceWhItemID, whConn->getFrom()->getWhItem(), pathInfo);
-                              }
-                          }
-                      });
+        pathsFingerprint -= sourceFingerprint(sourceItemID, sourcePaths);
+        sourcePaths.clear();
+
+        for(uint32_t target = 0; target < whGraph.getNodeCount(); ++target)
+        {
+            if(whGraph.isConveyor(target) || distances[target] == unreachable)
+            {
+                continue;
+            }
+
+            WarehousePathInfo_t pathInfo;
+            pathInfo.targetWhItemID = whGraph.getWhItemID(target);
+
+            for(uint32_t node = predecessors[target]; node != noPredecessor && node != source; node = predecessors[node])
+            {
+                pathInfo.pathToTarget.emplace_back(whGraph.getWhItemID(node), whGraph.getLength(node));
+            }
+
+            std::reverse(pathInfo.pathToTarget.begin(), pathInfo.pathToTarget.end());
+            sourcePaths.push_back(std::move(pathInfo));
+        }
+
+        pathsFingerprint += sourceFingerprint(sourceItemID, sourcePaths);
     }
 
     WarehousePathInfo_t* WarehousePathFinder_t::getShortestPath(int32_t lhsItemID, int32_t rhsItemID) const
     {
         WarehousePathInfo_t* shortestPath{ nullptr };
 
-        auto it = whPaths.find(lhsItemID);
+        auto it = whPaths->find(lhsItemID);
 
-        if(it != whPaths.end())
+        if(it != whPaths->end())
         {
             for(const WarehousePathInfo_t& pathInfo : it->second)
             {
@@ -168,6 +473,127 @@ namespace whm
         return shortestPath;
     }
 
+    const WarehousePaths_t& WarehousePathFinder_t::getPrecalculatedPaths() const
+    {
+        return *whPaths;
+    }
+
+    uint64_t WarehousePathFinder_t::getPathsFingerprint() const
+    {
+        return pathsFingerprint;
+    }
+
+    bool WarehousePathFinder_t::findRoute(const WarehouseLayoutGraph_t& whGraph, int32_t sourceItemID, const std::vector<int32_t>& targetItemIDs,
+                                          const NodeCost_t& nodeCost, size_t maxExpansions, WarehousePathInfo_t& route)
+    {
+        using QueueItem_t = std::pair<double, uint32_t>;
+
+        const int32_t source = whGraph.getNodeIndex(sourceItemID);
+
+        if(source == WarehouseLayoutGraph_t::E_NO_NODE)
+        {
+            return false;
+        }
+
+        if(routeStamps.size() != whGraph.getNodeCount())
+        {
+            routeStamps.assign(whGraph.getNodeCount(), 0);
+            routeTargetStamps.assign(whGraph.getNodeCount(), 0);
+            routeCosts.resize(whGraph.getNodeCount());
+            routePredecessors.resize(whGraph.getNodeCount());
+            routeStamp = 0;
+        }
+
+        // Buffers are not cleared, stale entries have older stamp
+        if(++routeStamp == 0)
+        {
+            std::fill(routeStamps.begin(), routeStamps.end(), 0);
+            std::fill(routeTargetStamps.begin(), routeTargetStamps.end(), 0);
+            routeStamp = 1;
+        }
+
+        for(int32_t targetItemID : targetItemIDs)
+        {
+            int32_t target = whGraph.getNodeIndex(targetItemID);
+
+            if(target != WarehouseLayoutGraph_t::E_NO_NODE)
+            {
+                routeTargetStamps[target] = routeStamp;
+            }
+        }
+
+        auto cost = [this](uint32_t node) -> double
+                    {
+                        return routeStamps[node] == routeStamp ? routeCosts[node] : std::numeric_limits<double>::infinity();
+                    };
+
+        routeQueue.clear();
+        routeQueue.emplace_back(0., source);
+        routeStamps[source] = routeStamp;
+        routeCosts[source] = 0.;
+
+        size_t expansions{ 0 };
+
+        // Dijkstra until the first target is settled, only conveyors are passed through
+        while(!routeQueue.empty())
+        {
+            std::pop_heap(routeQueue.begin(), routeQueue.end(), std::greater<QueueItem_t>());
+            auto [distance, node] = routeQueue.back();
+            routeQueue.pop_back();
+
+            if(distance > cost(node))
+            {
+                continue;
+            }
+
+            if(routeTargetStamps[node] == routeStamp)
+            {
+                route.targetWhItemID = whGraph.getWhItemID(node);
+                route.pathToTarget.clear();
+
+                for(uint32_t n = node; n != static_cast<uint32_t>(source); )
+                {
+                    n = routePredecessors[n];
+
+                    if(n != static_cast<uint32_t>(source))
+                    {
+                        route.pathToTarget.emplace_back(whGraph.getWhItemID(n), whGraph.getLength(n));
+                    }
+                }
+
+                std::reverse(route.pathToTarget.begin(), route.pathToTarget.end());
+                return true;
+            }
+
+            if(node != static_cast<uint32_t>(source) && !whGraph.isConveyor(node))
+            {
+                continue;
+            }
+
+            if(maxExpansions && ++expansions > maxExpansions)
+            {
+                return false;
+            }
+
+            for(const auto& edge : whGraph.getEdges(node))
+            {
+                double newDistance = distance + (whGraph.isConveyor(edge.to) ? edge.length * nodeCost(edge.to) : 0.);
+
+                if(newDistance < cost(edge.to))
+                {
+                    routeStamps[edge.to] = routeStamp;
+                    routeCosts[edge.to] = newDistance;
+                    routePredecessors[edge.to] = node;
+
+                    routeQueue.emplace_back(newDistance, edge.to);
+                    std::push_heap(routeQueue.begin(), routeQueue.end(), std::greater<QueueItem_t>());
+                }
+            }
+        }
+
+        return false;
+    }
+
     int32_t WarehousePathFinder_t::pathDistance(const WarehousePath_t& path) const
     {
         int32_t summedPathDistance{ 0 };
@@ -182,7 +608,7 @@ namespace whm
 
     void WarehousePathFinder_t::dump() const
     {
-        for(const auto& whPath : whPaths)
+        for(const auto& whPath : *whPaths)
         {
             std::cout << "-------------------------------------" << std::endl;
             std::cout << "Warehouse path(s) from <" << whPath.first << ">:" << std::endl;
@@ -9,14 +9,16 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <utility>
 #include <cstdint>
+#include <functional>
 #include <unordered_map>
 
 namespace whm
 {
-    class WarehouseItem_t;
+    class WarehouseLayoutGraph_t;
 
     using WarehousePath_t = std::vector<std::pair<int32_t, int32_t>>;
 
@@ -26,24 +28,58 @@ namespace whm
         WarehousePath_t pathToTarget;    //< Path to go to reach target item (item ids and distances)
     };
 
+    using WarehousePaths_t = std::unordered_map<int32_t, std::vector<WarehousePathInfo_t>>;
+
+    /**
+     * @brief Shortest paths between all non-conveyor items
+     *
+     * Copies of a path finder share the precalculated paths, new precalculation detaches them.
+     * Paths can be updated after layout edits, only sources whose paths may change are recalculated.
+     */
     class WarehousePathFinder_t
     {
         public:
+            /// Cost factor of passing a conveyor node (its length is multiplied by it)
+            using NodeCost_t = std::function<double(uint32_t)>;
+
             WarehousePathFinder_t();
             ~WarehousePathFinder_t();
 
             void clearPrecalculatedPaths();
-            void precalculatePaths(const std::vector<WarehouseItem_t*>&);
+            void precalculatePaths(const WarehouseLayoutGraph_t&);
+            void updatePaths(const WarehouseLayoutGraph_t&);
+            void sharePaths(const WarehousePathFinder_t&);
             WarehousePathInfo_t* getShortestPath(int32_t, int32_t) const;
+            const WarehousePaths_t& getPrecalculatedPaths() const;
+
+            /// Hash of all path lengths, changes whenever the precalculated paths do
+            uint64_t getPathsFingerprint() const;
+
+            // Path to the closest of targets searched on demand, false if more nodes than given limit (0 = none)
+            // would have to be expanded. Search buffers are kept between calls.
+            bool findRoute(const WarehouseLayoutGraph_t&, int32_t, const std::vector<int32_t>&, const NodeCost_t&, size_t, WarehousePathInfo_t&);
 
             int32_t pathDistance(const WarehousePath_t& path) const;
 
             void dump() const;
 
         protected:
-            void precalculatePaths(int32_t, const WarehouseItem_t*, WarehousePathInfo_t);
+            void precalculatePaths(const WarehouseLayoutGraph_t&, uint32_t);
+
+            // Distances from all items to given node of the graph paths were precalculated for
+            std::vector<int32_t> reverseDistances(const std::vector<uint32_t>&, const std::vector<uint32_t>&, uint32_t) const;
 
         private:
-            std::unordered_map<int32_t, std::vector<WarehousePathInfo_t>> whPaths;
+            std::shared_ptr<WarehousePaths_t> whPaths;
+            std::shared_ptr<const WarehouseLayoutGraph_t> pathsGraph;    //< Graph the paths were precalculated for
+            uint64_t pathsFingerprint{ 0 };                              //< Sum of hashes of all paths, kept per source
+
+            // State of on demand search, node belongs to current search if its stamp matches
+            uint32_t routeStamp{ 0 };
+            std::vector<uint32_t> routeStamps;
+            std::vector<uint32_t> routeTargetStamps;
+            std::vector<double> routeCosts;
+            std::vector<uint32_t> routePredecessors;
+            std::vector<std::pair<double, uint32_t>> routeQueue;
     };
 }
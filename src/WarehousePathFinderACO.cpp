@@ -9,8 +9,19 @@
 
 #if defined(WHM_PAF) || defined(WHM_SIM)
 
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <fstream>
 #include <iomanip>
 #include <numeric>
+#include <sstream>
+#include <exception>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
 
 #include "Logger.h"
 #include "WarehouseItem.h"
@@ -18,11 +29,69 @@
 #include "WarehouseTypes.h"
 #include "WarehouseLayout.h"
 #include "WarehouseOrderLine.h"
+#include "WarehouseTourSearch.h"
 #include "WarehouseLocationRack.h"
 #include "WarehousePathFinderACO.h"
 
 namespace whm
 {
+    namespace
+    {
+        /// SplitMix64 finalizer, consecutive inputs give independent outputs
+        uint64_t mix(uint64_t z)
+        {
+            z += 0x9e3779b97f4a7c15ULL;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+            return z ^ (z >> 31);
+        }
+
+        void evaporateAndClampScalar(double* values, size_t size, double factor, double minimum)
+        {
+            for(size_t i = 0; i < size; ++i)
+            {
+                values[i] = std::max(factor * values[i], minimum);
+            }
+        }
+
+#       if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        /// Same results as the scalar version, max(a, b) of AVX returns b when a is not greater
+        __attribute__((target("avx2")))
+        void evaporateAndClampAvx2(double* values, size_t size, double factor, double minimum)
+        {
+            const __m256d f = _mm256_set1_pd(factor);
+            const __m256d m = _mm256_set1_pd(minimum);
+
+            size_t i{ 0 };
+
+            for(; i + 4 <= size; i += 4)
+            {
+                __m256d v = _mm256_load_pd(values + i);
+                _mm256_store_pd(values + i, _mm256_max_pd(_mm256_mul_pd(v, f), m));
+            }
+
+            evaporateAndClampScalar(values + i, size - i, factor, minimum);
+        }
+#       endif
+
+        /// values = max(factor * values, minimum), values have to be 32 byte aligned
+        void evaporateAndClamp(double* values, size_t size, double factor, double minimum)
+        {
+#           if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            static const bool avx2 = __builtin_cpu_supports("avx2");
+
+            if(avx2)
+            {
+                evaporateAndClampAvx2(values, size, factor, minimum);
+                return;
+            }
+#           endif
+
+            evaporateAndClampScalar(values, size, factor, minimum);
+        }
+    }
+
     WarehousePathFinderACO_t::WarehousePathFinderACO_t(const utils::WhmArgs_t& args_)
         : cfg{ ConfigParser_t{ "cfg/pathfinder.xml" } }
         , args{ args_ }
@@ -37,6 +106,17 @@ namespace whm
         init();
     }
 
+    WarehousePathFinderACO_t::WarehousePathFinderACO_t(const WarehousePathFinderACO_t& other)
+        : WarehousePathFinder_t{ other }
+        , IWarehousePathFinderACO_t{ other }
+        , cfg{ other.cfg }
+        , args{ other.args }
+        , tourCache{ other.tourCache }
+    {
+        std::random_device rd;
+        rand.seed(rd());
+    }
+
     WarehousePathFinderACO_t::~WarehousePathFinderACO_t()
     {
 
@@ -44,33 +124,44 @@ namespace whm
 
     void WarehousePathFinderACO_t::init()
     {
-        std::random_device rd;
-        rand.seed(rd());
+        if(cfg.isSet("seed"))
+        {
+            rand.seed(cfg.getAs<int32_t>("seed"));
+        }
+        else
+        {
+            std::random_device rd;
+            rand.seed(rd());
+        }
 
-        precalculatePaths(whm::WarehouseLayout_t::getWhLayout().getWhItems());
+        sharePaths(whm::WarehouseLayout_t::getWhLayout().getWhPathFinder());
+
+        if(cfg.isSet("tourCache") && cfg.getAs<bool>("tourCache"))
+        {
+            tourCache = std::make_shared<WarehouseTourCache_t>(cfg.isSet("tourCacheSize") ? cfg.getAs<int32_t>("tourCacheSize") : 0,
+                                                               cfg.isSet("tourCacheFile") ? cfg.getAs<std::string>("tourCacheFile") : std::string());
+        }
     }
 
     void WarehousePathFinderACO_t::prepareOptimization()
     {
-        lookupStartFinish();
+        // Start, finish and locations of the order are already known
 
-        findLocationsToVisit();
+        distances.assign(dimension, dimension, 0);
 
         for(int32_t i = 0; i < dimension; ++i)
         {
-            std::vector<int32_t> d;
-
             for(int32_t j = 0; j < dimension; ++j)
             {
                 auto* shortestPath = getShortestPath(locations.at(i), locations.at(j));
 
-                if(shortestPath)
+                if(!shortestPath)
                 {
-                    d.push_back(pathDistance(shortestPath->pathToTarget));
+                    throw std::runtime_error("PathFinder: no path between locations to visit!");
                 }
-            }
 
-            distances.emplace_back(std::move(d));
+                distances(i, j) = pathDistance(shortestPath->pathToTarget);
+            }
         }
 
         for(int32_t it = 0; it < dimension; ++it)
@@ -78,16 +169,16 @@ namespace whm
             nearestNeighbours.push_back(findNearestNeighbours(it));
         }
 
+        double beta = cfg.getAs<double>("beta");
+
+        heuristics.assign(dimension, dimension, 0.);
+
         for(int32_t i = 0; i < dimension; ++i)
         {
-            std::vector<double> h;
-
             for(int32_t j = 0; j < dimension; ++j)
             {
-                h.push_back(1.0 / std::pow(distances.at(i).at(j), cfg.getAs<double>("beta")));
+                heuristics(i, j) = 1.0 / std::pow(distances(i, j), beta);
             }
-
-            heuristics.emplace_back(std::move(h));
         }
 
         this->probBest = cfg.getAs<double>("probBest");
@@ -125,8 +216,6 @@ namespace whm
         auto& whItems = whm::WarehouseLayout_t::getWhLayout().getWhItems();
         auto& whOrders = whm::WarehouseLayout_t::getWhLayout().getWhOrders();
 
-        auto selectedOrderID = cfg.getAs<int32_t>("selectedOrderID");
-
         if(selectedOrderID < 0 || selectedOrderID >= static_cast<int32_t>(whOrders.size()))
         {
             Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "PathFinder: selectedOrderID out of range!");
@@ -157,11 +246,11 @@ namespace whm
             locations.push_back(loc);
         }*/
 
-        auto& whOrder = whOrders.at(selectedOrderID);
+        auto whOrder = whOrders.at(selectedOrderID);
 
-        for(auto& whLine : whOrder.getWhOrderLines())
+        for(const auto& whLine : whOrder.getWhOrderLines())
         {
-            auto article = whLine.getArticle();
+            auto article = whLine.getArticleID();
 
             for(auto* whItem : whItems)
             {
@@ -209,7 +298,7 @@ namespace whm
 
     int32_t WarehousePathFinderACO_t::getLocationsDistance(int32_t y, int32_t x)
     {
-        return distances.at(y).at(x);
+        return distances(y, x);
     }
 
     int32_t WarehousePathFinderACO_t::getPathDistance(const std::vector<int32_t>& path)
@@ -220,7 +309,7 @@ namespace whm
         {
             for(size_t i = 1; i < path.size(); ++i)
             {
-                d += getLocationsDistance(path.at(i-1), path.at(i));
+                d += getLocationsDistance(path[i-1], path[i]);
             }
         }
 
@@ -239,89 +328,99 @@ namespace whm
         return dist(rand);
     }
 
-    int32_t WarehousePathFinderACO_t::rouletteSelection(double sum, std::vector<double> const& vals)
+    int32_t WarehousePathFinderACO_t::rouletteSelection(WarehouseAnt_t& whAnt, int32_t loc)
     {
-        int32_t idx{ 0 };
-        double iter{ 0.0 };
-        double random{ randomFromInterval(0.0, 1.0) * sum }; // Make sure of using floating point overloaded func
-
-        for(auto v : vals)
-        {
-            ++ idx;
-            iter += v;
+        const auto& nns = nearestNeighbours[loc];
+        const double* weights = choiceWeights.row(loc);
+        const double* sums = choiceSums.row(loc);
+        const size_t k = nns.size();
 
-            if(Logger_t::getLogger().isVerbose())
-            {
-                std::cout << "RW: " << random << " / " << v << " / " << iter << std::endl;
-            }
+        size_t unvisited{ 0 };
 
-            if(random < iter)
-            {
-                break;
-            }
+        for(size_t j = 0; j < k; ++j)
+        {
+            unvisited += !whAnt.visited(nns[j]);
         }
 
-        if(Logger_t::getLogger().isVerbose())
+        if(!unvisited)
         {
-            std::cout << "RW return: " << idx - 1 << std::endl;
+            return -1;
         }
 
-        return idx - 1;
-    }
+        // Whole list is open, cumulative sums of the iteration are valid
+        if(unvisited == k)
+        {
+            double random{ whAnt.random() * sums[k - 1] };
+            size_t idx = std::upper_bound(sums, sums + k, random) - sums;
 
-    bool WarehousePathFinderACO_t::performNextAntStep(WarehouseAnt_t& whAnt)
-    {
-        auto lastVisitedLoc = whAnt.getVisited().back();
-        auto lastVisitedLocNn = nearestNeighbours.at(lastVisitedLoc);
+            return nns[std::min(idx, k - 1)];
+        }
 
-        std::vector<int32_t> candidates;
+        double sum{ 0.0 };
 
-        for(auto loc : lastVisitedLocNn)
+        for(size_t j = 0; j < k; ++j)
         {
-            if(!whAnt.visited(loc))
+            if(!whAnt.visited(nns[j]))
             {
-                candidates.push_back(loc);
+                sum += weights[j];
             }
         }
 
-        if(Logger_t::getLogger().isVerbose())
-        {
-            std::cout << "Perform WH ant step: Candidates: ";
-            std::for_each(candidates.begin(), candidates.end(), [](auto c){ std::cout << c << ", "; });
-            std::cout << std::endl;
-        }
-
-        auto nextLoc = lastVisitedLoc;
+        double random{ whAnt.random() * sum };
+        double iter{ 0.0 };
+        int32_t selected{ -1 };
 
-        if(!candidates.empty())
+        for(size_t j = 0; j < k; ++j)
         {
-            double pheromoneSum{ 0.0 };
-            std::vector<double> pheromoneValues;
-
-            for(auto c : candidates)
+            if(!whAnt.visited(nns[j]))
             {
-                if(c == whFinish)
+                iter += weights[j];
+                selected = nns[j];
+
+                if(random < iter)
                 {
-                    continue;
+                    break;
                 }
+            }
+        }
 
-                if(!whAnt.visited(c))
-                {
-                    double candidatePheromone = edgePheromones.at(lastVisitedLoc).at(c);
-                    candidatePheromone *= heuristics.at(lastVisitedLoc).at(c);
+        return selected;
+    }
 
-                    pheromoneSum += candidatePheromone;
-                    pheromoneValues.push_back(candidatePheromone);
+    void WarehousePathFinderACO_t::updateChoiceWeights()
+    {
+        const size_t k = nearestNeighbours.empty() ? 0 : nearestNeighbours.front().size();
 
-                    if(Logger_t::getLogger().isVerbose())
-                    {
-                        std::cout << "Perform WH ant step: Candidate " << c << ": " << candidatePheromone << " (" << pheromoneSum << ")\n";
-                    }
-                }
+        choiceWeights.assign(dimension, k, 0.);
+        choiceSums.assign(dimension, k, 0.);
+
+        for(int32_t i = 0; i < dimension; ++i)
+        {
+            const auto& nns = nearestNeighbours[i];
+            double* weights = choiceWeights.row(i);
+            double* sums = choiceSums.row(i);
+            double sum{ 0.0 };
+
+            for(size_t j = 0; j < nns.size(); ++j)
+            {
+                weights[j] = edgePheromones(i, nns[j]) * heuristics(i, nns[j]);
+                sum += weights[j];
+                sums[j] = sum;
             }
+        }
+    }
+
+    bool WarehousePathFinderACO_t::performNextAntStep(WarehouseAnt_t& whAnt)
+    {
+        auto lastVisitedLoc = whAnt.getVisited().back();
+        auto nextLoc = lastVisitedLoc;
+
+        // Roulette wheel selection of candidates (not yet visited nearest neighbours)
+        int32_t selected = rouletteSelection(whAnt, lastVisitedLoc);
 
-            // Roulette wheel selection of candidates (not yet visited nearest neighbours)
-            nextLoc = candidates.at(rouletteSelection(pheromoneSum, pheromoneValues));
+        if(selected >= 0)
+        {
+            nextLoc = selected;
         }
         else
         {
@@ -337,28 +436,18 @@ namespace whm
 
                 if(!whAnt.visited(it))
                 {
-                    double candidatePheromone = edgePheromones.at(lastVisitedLoc).at(it);
-                    candidatePheromone *= heuristics.at(lastVisitedLoc).at(it);
+                    double candidatePheromone = edgePheromones(lastVisitedLoc, it);
+                    candidatePheromone *= heuristics(lastVisitedLoc, it);
 
                     if(candidatePheromone > maxPheromone)
                     {
                         maxPheromone = candidatePheromone;
                         nextLoc = it;
                     }
-
-                    if(Logger_t::getLogger().isVerbose())
-                    {
-                        std::cout << "Perform WH ant step: Iteration " << it << ": " << candidatePheromone << " (" << maxPheromone << ")\n";
-                    }
                 }
             }
         }
 
-        if(Logger_t::getLogger().isVerbose())
-        {
-            std::cout << "Perform WH ant step: Next location: " << nextLoc << std::endl;
-        }
-
         if(nextLoc == lastVisitedLoc)
         {
             // Ant already visited all locations
@@ -392,6 +481,7 @@ namespace whm
     {
         WarehouseAnt_t whAnt;
 
+        whAnt.reset(dimension);
         whAnt.visit(whStart);
 
         auto actualLoc = whStart;
@@ -461,14 +551,16 @@ namespace whm
     {
         dimension = 0;
 
-        bestWhAnt = WarehouseAnt_t();
+        // Ants keep their buffers for the next order
+        bestWhAnt.reset(0);
 
-        whAnts.clear();
         locations.clear();
         distances.clear();
         heuristics.clear();
         edgePheromones.clear();
         nearestNeighbours.clear();
+        choiceWeights.clear();
+        choiceSums.clear();
     }
 
     void WarehousePathFinderACO_t::dump() const
@@ -491,8 +583,8 @@ namespace whm
 
             for(int32_t j = 0; j < dimension; ++j)
             {
-                std::cout << std::setw(4)  << distances.at(i).at(j)
-                          << std::setw(16) << heuristics.at(i).at(j)
+                std::cout << std::setw(4)  << distances.at(i, j)
+                          << std::setw(16) << heuristics.at(i, j)
                           ; //<< std::setw(4)  << edgePheromones.at(i).at(j)
             }
 
@@ -507,69 +599,450 @@ namespace whm
 
     void WarehousePathFinderACO_t::calcStats()
     {
-        int32_t sumCost{ 0 };
+        struct OrderStats_t
+        {
+            bool done{ false };
+            int32_t locationCount{ 0 };
+            int32_t cost{ 0 };
+            double time{ 0. };
+            SolverType_t solver{ SolverType_t::E_ACO };
+            int32_t colonyCost{ 0 };  //< Plain ACO on exactly solved order, when gap is reported
+        };
 
         const auto& whOrders = whm::WarehouseLayout_t::getWhLayout().getWhOrders();
+        const size_t orderCount = whOrders.size();
+
+        int32_t threads = cfg.isSet("threads") ? cfg.getAs<int32_t>("threads") : 1;
 
-        for(size_t i = 0; i < whOrders.size(); ++i)
+        if(threads <= 0)
         {
-            cfg.set("selectedOrderID", std::to_string(i));
+            threads = static_cast<int32_t>(std::thread::hardware_concurrency());
+        }
 
-            findPath();
+        // Verbose dumps of solvers would interleave
+        size_t threadCount = Logger_t::getLogger().isVerbose() ? 1 : std::max<size_t>(1, std::min<size_t>(threads, orderCount));
 
-            sumCost += getBestPathCost();
+        // Each order has its own seed, so results do not depend on which solver takes it
+        uint64_t statsSeed = cfg.isSet("seed") ? static_cast<uint64_t>(cfg.getAs<int32_t>("seed")) : std::random_device{}();
+        bool reportGap = cfg.isSet("reportGap") && cfg.getAs<bool>("reportGap");
 
-            clearPathFinder();
+        std::ofstream csvStream;
+
+        if(cfg.isSet("statsFile"))
+        {
+            csvStream.open(cfg.getAs<std::string>("statsFile"));
+
+            if(!csvStream.is_open())
+            {
+                throw std::runtime_error("PathFinder: failed to open stats file!");
+            }
+
+            csvStream << "Order ID;Locations;Cost [m];Time [ms];Solver\n";
+        }
+
+        std::vector<OrderStats_t> stats(orderCount);
+        std::atomic<size_t> nextOrder{ 0 };
+        size_t nextWritten{ 0 };
+        std::exception_ptr error;
+        std::mutex mutex;
+
+        auto solveOrders = [&](WarehousePathFinderACO_t& solver)
+                           {
+                               for(size_t i = nextOrder++; i < orderCount; i = nextOrder++)
+                               {
+                                   try
+                                   {
+                                       auto start = std::chrono::steady_clock::now();
+
+                                       std::seed_seq seq{ static_cast<uint32_t>(statsSeed), static_cast<uint32_t>(statsSeed >> 32), static_cast<uint32_t>(i) };
+                                       solver.rand.seed(seq);
+
+                                       solver.clearPathFinder();
+                                       solver.selectedOrderID = static_cast<int32_t>(i);
+                                       solver.solve();
+
+                                       std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+                                       OrderStats_t orderStats{ true, std::max(solver.getInteriorCount(), 0), solver.getBestPathCost(), elapsed.count(), solver.solver, 0 };
+
+                                       // Same order once more by ants alone
+                                       if(reportGap && solver.solver == SolverType_t::E_EXACT)
+                                       {
+                                           solver.bestWhAnt.reset(0);
+                                           solver.bestWhAnt.setCost(std::numeric_limits<int32_t>::max());
+                                           solver.solveColony(false);
+
+                                           orderStats.colonyCost = solver.getBestPathCost();
+                                       }
+
+                                       std::lock_guard<std::mutex> lock(mutex);
+
+                                       stats[i] = orderStats;
+
+                                       // Rows are streamed in order of orders as soon as all previous ones are solved
+                                       for(; nextWritten < orderCount && stats[nextWritten].done; ++nextWritten)
+                                       {
+                                           if(csvStream.is_open())
+                                           {
+                                               const auto& s = stats[nextWritten];
+                                               writeStats(csvStream, nextWritten, s.locationCount, s.cost, s.time, s.solver);
+                                           }
+                                       }
+                                   }
+                                   catch(...)
+                                   {
+                                       std::lock_guard<std::mutex> lock(mutex);
+
+                                       error = error ? error : std::current_exception();
+                                       nextOrder = orderCount;
+                                   }
+                               }
+                           };
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "[ACO] Solving <%zu> orders with <%zu> solvers", orderCount, threadCount);
+
+        // This object is one of the solvers, others share its paths
+        std::vector<std::unique_ptr<WarehousePathFinderACO_t>> solvers;
+        std::vector<std::thread> workers;
+
+        std::string antThreads = std::to_string(threads);
+
+        // Threads are already busy with orders, ants of each order are constructed serially
+        if(threadCount > 1)
+        {
+            cfg.set("threads", "1");
+        }
+
+        for(size_t t = 1; t < threadCount; ++t)
+        {
+            solvers.push_back(std::make_unique<WarehousePathFinderACO_t>(*this));
+        }
+
+        for(auto& solver : solvers)
+        {
+            workers.emplace_back(solveOrders, std::ref(*solver));
+        }
+
+        solveOrders(*this);
+
+        for(auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        cfg.set("threads", antThreads);
+
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+
+        int32_t sumCost{ 0 };
+        size_t exactCount{ 0 };
+        int64_t exactCost{ 0 };
+        int64_t colonyCost{ 0 };
+
+        for(const auto& s : stats)
+        {
+            sumCost += s.cost;
+
+            if(s.solver == SolverType_t::E_EXACT)
+            {
+                ++exactCount;
+                exactCost += s.cost;
+                colonyCost += s.colonyCost;
+            }
         }
 
         whm::Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "[ACO] Summed best cost over %zu orders: %d [m]",
-                                         whOrders.size(), sumCost);
+                                         orderCount, sumCost);
+
+        if(tourCache)
+        {
+            whm::Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "[ACO] Tour cache: <%zu> hits, <%zu> misses, <%zu> tours",
+                                             tourCache->getHits(), tourCache->getMisses(), tourCache->size());
+        }
+
+        if(reportGap && exactCost > 0)
+        {
+            whm::Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "[ACO] Optimum of %zu orders: %lld [m], ACO: %lld [m], gap %.3f %%",
+                                             exactCount, static_cast<long long>(exactCost), static_cast<long long>(colonyCost),
+                                             100.0 * (colonyCost - exactCost) / exactCost);
+        }
+    }
+
+    void WarehousePathFinderACO_t::writeStats(std::ostream& os, size_t orderID, int32_t locationCount, int32_t cost, double time, SolverType_t solverType) const
+    {
+        static const char* solverNames[] = { "exact", "aco", "greedy", "cached" };
+
+        os << orderID << ';' << locationCount << ';' << cost << ';' << std::fixed << std::setprecision(3) << time << ';'
+           << solverNames[to_underlying(solverType)] << '\n';
     }
 
-    std::vector<int32_t> WarehousePathFinderACO_t::findPath(int32_t selectedOrderID)
+    std::vector<int32_t> WarehousePathFinderACO_t::findPath(int32_t selectedOrderID_)
     {
         // Note: special function for simulator
 
         clearPathFinder();
 
-        cfg.set("selectedOrderID", std::to_string(selectedOrderID));
+        selectedOrderID = selectedOrderID_;
 
-        findPath();
+        solve();
 
         return decodePath(getBestPath());
     }
 
     void WarehousePathFinderACO_t::findPath()
     {
+        selectedOrderID = cfg.getAs<int32_t>("selectedOrderID");
+
+        solve();
+    }
+
+    void WarehousePathFinderACO_t::solve()
+    {
+        lookupStartFinish();
+
+        findLocationsToVisit();
+
+        if(findCachedTour())
+        {
+            return;
+        }
+
         prepareOptimization();
 
+        int32_t exactLimit = cfg.isSet("exactLimit") ? std::min(cfg.getAs<int32_t>("exactLimit"), E_MAX_EXACT_SIZE) : 0;
+
+        if(getInteriorCount() <= exactLimit)
+        {
+            solveExact();
+        }
+        else
+        {
+            solveColony(cfg.isSet("localSearch") && cfg.getAs<bool>("localSearch"));
+        }
+
+        cacheBestTour();
+    }
+
+    WarehouseTourCache_t::Key_t WarehousePathFinderACO_t::getTourKey() const
+    {
+        std::vector<int32_t> interior;
+
+        for(int32_t i = 0; i < dimension; ++i)
+        {
+            if(i != whStart && i != whFinish)
+            {
+                interior.push_back(locations[i]);
+            }
+        }
+
+        return WarehouseTourCache_t::makeKey(locations[whStart], locations[whFinish], std::move(interior));
+    }
+
+    bool WarehousePathFinderACO_t::findCachedTour()
+    {
+        WarehouseTourCache_t::Tour_t tour;
+
+        if(!tourCache || !tourCache->find(getPathsFingerprint(), getTourKey(), tour))
+        {
+            return false;
+        }
+
+        // Tour holds item IDs, order of locations differs between orders
+        bestWhAnt.reset(dimension);
+
+        for(int32_t whItemID : tour.whItemIDs)
+        {
+            auto it = std::find(locations.begin(), locations.end(), whItemID);
+
+            if(it == locations.end())
+            {
+                break;
+            }
+
+            bestWhAnt.visit(static_cast<int32_t>(it - locations.begin()));
+        }
+
+        // Damaged file, solve the order again
+        if(static_cast<int32_t>(bestWhAnt.getVisited().size()) != dimension)
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_WARNING, "PathFinder: cached tour does not match the order, ignoring it");
+            return false;
+        }
+
+        bestWhAnt.setCost(tour.cost);
+        solver = SolverType_t::E_CACHED;
+
+        return true;
+    }
+
+    void WarehousePathFinderACO_t::cacheBestTour()
+    {
+        if(!tourCache || bestWhAnt.getVisited().empty())
+        {
+            return;
+        }
+
+        WarehouseTourCache_t::Tour_t tour;
+        tour.cost = bestWhAnt.getCost();
+
+        for(int32_t loc : bestWhAnt.getVisited())
+        {
+            tour.whItemIDs.push_back(locations[loc]);
+        }
+
+        tourCache->insert(getPathsFingerprint(), getTourKey(), tour);
+    }
+
+    int32_t WarehousePathFinderACO_t::getInteriorCount() const
+    {
+        return dimension - (whStart == whFinish ? 1 : 2);
+    }
+
+    void WarehousePathFinderACO_t::solveExact()
+    {
+        std::vector<int32_t> nodes;
+
+        for(int32_t loc = 0; loc < dimension; ++loc)
+        {
+            if(loc != whStart && loc != whFinish)
+            {
+                nodes.push_back(loc);
+            }
+        }
+
+        const size_t n = nodes.size();
+        const size_t full = (size_t{ 1 } << n) - 1;
+        constexpr int32_t unreachable = std::numeric_limits<int32_t>::max();
+
+        // Held-Karp: cost of the cheapest path from start through locations of mask ending in j
+        exactCosts.assign((full + 1) * n, unreachable);
+        exactParents.assign((full + 1) * n, -1);
+
+        for(size_t j = 0; j < n; ++j)
+        {
+            exactCosts[(size_t{ 1 } << j) * n + j] = distances(whStart, nodes[j]);
+        }
+
+        for(size_t mask = 1; mask <= full; ++mask)
+        {
+            for(size_t j = 0; j < n; ++j)
+            {
+                int32_t cost = exactCosts[mask * n + j];
+
+                if(cost == unreachable || !(mask >> j & 1))
+                {
+                    continue;
+                }
+
+                for(size_t k = 0; k < n; ++k)
+                {
+                    if(mask >> k & 1)
+                    {
+                        continue;
+                    }
+
+                    size_t next = (mask | (size_t{ 1 } << k)) * n + k;
+                    int32_t candidate = cost + distances(nodes[j], nodes[k]);
+
+                    if(candidate < exactCosts[next])
+                    {
+                        exactCosts[next] = candidate;
+                        exactParents[next] = static_cast<int8_t>(j);
+                    }
+                }
+            }
+        }
+
+        // Walk back from the cheapest last location
+        std::vector<int32_t> tour{ whFinish };
+
+        if(n > 0)
+        {
+            size_t last{ 0 };
+            int32_t best{ unreachable };
+
+            for(size_t j = 0; j < n; ++j)
+            {
+                int32_t cost = exactCosts[full * n + j];
+
+                if(cost != unreachable && cost + distances(nodes[j], whFinish) < best)
+                {
+                    best = cost + distances(nodes[j], whFinish);
+                    last = j;
+                }
+            }
+
+            for(size_t mask = full; mask; )
+            {
+                int8_t parent = exactParents[mask * n + last];
+
+                tour.push_back(nodes[last]);
+                mask &= ~(size_t{ 1 } << last);
+                last = static_cast<size_t>(parent);
+            }
+        }
+
+        tour.push_back(whStart);
+        std::reverse(tour.begin(), tour.end());
+
+        setBestTour(tour);
+        solver = SolverType_t::E_EXACT;
+    }
+
+    void WarehousePathFinderACO_t::setBestTour(const std::vector<int32_t>& tour)
+    {
+        bestWhAnt.reset(dimension);
+
+        for(auto loc : tour)
+        {
+            bestWhAnt.visit(loc);
+        }
+
+        bestWhAnt.setCost(getPathDistance(bestWhAnt.getVisited()));
+    }
+
+    void WarehousePathFinderACO_t::improveBestTour()
+    {
+        std::vector<int32_t> bestTour = bestWhAnt.getVisited();
+
+        tour::improve(distances, bestTour);
+
+        if(getPathDistance(bestTour) < bestWhAnt.getCost())
+        {
+            setBestTour(bestTour);
+        }
+    }
+
+    void WarehousePathFinderACO_t::solveColony(bool localSearch)
+    {
+        solver = SolverType_t::E_ACO;
+
         auto const& sol = this->constructGreedySolution();
         double evalSol  = this->getPathDistance(sol);
 
         updatePheromoneMinMax(evalSol);
 
         initPheromones();
+        updateChoiceWeights();
+
+        whAnts.resize(std::max(cfg.getAs<int32_t>("antCount"), 0));
+        searchSeed = std::uniform_int_distribution<uint64_t>()(rand);
 
         for(int32_t it = 0; it < cfg.getAs<int32_t>("maxIterations"); ++it)
         {
-            for(int32_t a = 0; a < cfg.getAs<int32_t>("antCount"); ++a)
-            {
-                WarehouseAnt_t whAnt;
-                whAnt.visit(whStart);
-                while(performNextAntStep(whAnt));
-                whAnt.visit(whFinish);
-                whAnt.setCost(getPathDistance(whAnt.getVisited()));
-                whAnts.emplace_back(std::move(whAnt));
-            }
+            constructAnts(it);
 
-            WarehouseAnt_t iterationBestWhAnt;
-            iterationBestWhAnt.setCost(std::numeric_limits<int32_t>::max());
+            // Ants of earlier iterations used to stay in the colony, the first best of them is the best ant
+            const WarehouseAnt_t* iterationBestWhAnt = &bestWhAnt;
 
             for(WarehouseAnt_t& whAnt : whAnts)
             {
-                if(whAnt < iterationBestWhAnt)
+                if(whAnt < *iterationBestWhAnt)
                 {
-                    iterationBestWhAnt = whAnt;
+                    iterationBestWhAnt = &whAnt;
                 }
                 if(whAnt < bestWhAnt)
                 {
@@ -577,7 +1050,7 @@ namespace whm
 
                     if(randomFromInterval(0.0, 1.0) < cfg.getAs<double>("probUseIterationBest"))
                     {
-                        updatePheromoneMinMax(iterationBestWhAnt.getCost());
+                        updatePheromoneMinMax(iterationBestWhAnt->getCost());
                     }
                     else
                     {
@@ -600,42 +1073,139 @@ namespace whm
             evaporation(1.0 - cfg.getAs<double>("rho"));
 
             // Deposit pheromone on all edges that 'iteration best' ant visited
-            auto prevLocation = iterationBestWhAnt.getVisited().back();
-            for(auto location : iterationBestWhAnt.getVisited())
+            auto prevLocation = iterationBestWhAnt->getVisited().back();
+            for(auto location : iterationBestWhAnt->getVisited())
             {
-                deposit(prevLocation, location, 1.0 / iterationBestWhAnt.getCost());
+                deposit(prevLocation, location, 1.0 / iterationBestWhAnt->getCost());
 
                 prevLocation = location;
             }
 
+            updateChoiceWeights();
+
             if(!args.stats)
             {
                 whm::Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "[ACO] [%3d] Best cost: %d", it, bestWhAnt.getCost());
+            }
+        }
+
+        // Cost history is dumped once, not with every iteration
+        if(!args.stats && Logger_t::getLogger().isEnabled(LogLevel_t::E_DEBUG))
+        {
+            std::ostringstream history;
+
+            std::for_each(results.begin(), results.end(), [&history](double v){ history << v << ", "; });
+            history << '\n';
+
+            Logger_t::getLogger().printRaw(history.str());
+        }
 
-                std::for_each(results.begin(), results.end(), [](double v){ std::cout << v << ", "; });
-                std::cout << std::endl;
+        // No ant was constructed
+        if(bestWhAnt.getCost() == std::numeric_limits<int32_t>::max())
+        {
+            setBestTour(sol);
+            solver = SolverType_t::E_GREEDY;
+        }
+
+        if(localSearch)
+        {
+            improveBestTour();
+        }
+    }
+
+    void WarehousePathFinderACO_t::constructAnts(int32_t iteration)
+    {
+        auto construct = [this, iteration](size_t a)
+                         {
+                             auto& whAnt = whAnts[a];
+
+                             // Stream of each ant is given by search, iteration and ant, not by the thread
+                             whAnt.seed(mix(searchSeed ^ mix((static_cast<uint64_t>(iteration) << 32) | a)));
+                             whAnt.reset(dimension);
+                             whAnt.visit(whStart);
+                             while(performNextAntStep(whAnt));
+                             whAnt.visit(whFinish);
+                             whAnt.setCost(getPathDistance(whAnt.getVisited()));
+                         };
+
+        // Verbose output of ants would interleave
+        if(dimension < E_MIN_PARALLEL_DIMENSION || Logger_t::getLogger().isVerbose())
+        {
+            for(size_t a = 0; a < whAnts.size(); ++a)
+            {
+                construct(a);
             }
+
+            return;
         }
+
+        if(!threadPool)
+        {
+            int32_t threads = cfg.isSet("threads") ? cfg.getAs<int32_t>("threads") : 1;
+
+            if(threads <= 0)
+            {
+                threads = static_cast<int32_t>(std::thread::hardware_concurrency());
+            }
+
+            threadPool = std::make_unique<WarehouseThreadPool_t>(std::max(threads, 1));
+        }
+
+        threadPool->parallelFor(whAnts.size(), construct);
+    }
+
+    void WarehousePathFinderACO_t::WarehouseAnt_t::reset(int32_t dimension)
+    {
+        cost = 0;
+
+        visitedLocations.clear();
+        visitedLocations.reserve(dimension + 1);
+
+        visitedMask.assign((dimension + 63) / 64, 0);
     }
 
     void WarehousePathFinderACO_t::WarehouseAnt_t::visit(int32_t loc)
     {
-        if(!visited(loc))
+        size_t word = static_cast<size_t>(loc) / 64;
+
+        if(word >= visitedMask.size())
         {
+            visitedMask.resize(word + 1, 0);
+        }
+
+        uint64_t bit = uint64_t{ 1 } << (loc % 64);
+
+        if(!(visitedMask[word] & bit))
+        {
+            visitedMask[word] |= bit;
             visitedLocations.push_back(loc);
         }
     }
 
-    bool WarehousePathFinderACO_t::WarehouseAnt_t::visited(int32_t loc)
+    bool WarehousePathFinderACO_t::WarehouseAnt_t::visited(int32_t loc) const
     {
-        return utils::contains(visitedLocations, loc);
+        size_t word = static_cast<size_t>(loc) / 64;
+
+        return word < visitedMask.size() && (visitedMask[word] >> (loc % 64) & 1);
     }
 
-    std::vector<int32_t> WarehousePathFinderACO_t::WarehouseAnt_t::getVisited() const
+    const std::vector<int32_t>& WarehousePathFinderACO_t::WarehouseAnt_t::getVisited() const
     {
         return visitedLocations;
     }
 
+    void WarehousePathFinderACO_t::WarehouseAnt_t::seed(uint64_t key)
+    {
+        randomKey = key;
+        randomCounter = 0;
+    }
+
+    double WarehousePathFinderACO_t::WarehouseAnt_t::random()
+    {
+        // Upper 53 bits give uniform double in [0, 1)
+        return (mix(randomKey + mix(randomCounter++)) >> 11) * 0x1.0p-53;
+    }
+
     void WarehousePathFinderACO_t::WarehouseAnt_t::setCost(int32_t c)
     {
         this->cost = c;
@@ -648,37 +1218,19 @@ namespace whm
 
     void WarehousePathFinderACO_t::initPheromones()
     {
-        for(int32_t i = 0; i < dimension; ++i)
-        {
-            std::vector<double> p;
-
-            for(int32_t j = 0; j < dimension; ++j)
-            {
-                p.push_back(pheromoneMax);
-            }
-
-            edgePheromones.emplace_back(std::move(p));
-        }
+        edgePheromones.assign(dimension, dimension, pheromoneMax);
     }
 
     void WarehousePathFinderACO_t::evaporation(double rate)
     {
-        for(auto& eps : edgePheromones)
-        {
-            std::for_each(eps.begin(), eps.end(),
-                          [=](double& ep)
-                          -> void
-                          {
-                              ep = std::max((1 - rate) * ep, pheromoneMin);
-                          });
-        }
+        evaporateAndClamp(edgePheromones.data(), edgePheromones.size(), 1 - rate, pheromoneMin);
     }
 
     void WarehousePathFinderACO_t::deposit(int32_t y, int32_t x, double increase)
     {
-        double actEdgePheromones = edgePheromones.at(y).at(x);
+        double actEdgePheromones = edgePheromones(y, x);
 
-        edgePheromones.at(y).at(x) = std::min(actEdgePheromones + increase, pheromoneMax);
+        edgePheromones(y, x) = std::min(actEdgePheromones + increase, pheromoneMax);
     }
 }
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <random>
 #include <unistd.h>
@@ -21,6 +22,9 @@
 
 #include "Utils.h"
 #include "ConfigParser.h"
+#include "WarehouseMatrix.h"
+#include "WarehouseTourCache.h"
+#include "WarehouseThreadPool.h"
 #include "WarehousePathFinder.h"
 
 namespace whm
@@ -35,6 +39,15 @@ namespace whm
     class WarehousePathFinderACO_t : public WarehousePathFinder_t,
                                      public IWarehousePathFinderACO_t
     {
+        public:
+            enum class SolverType_t
+            {
+                E_EXACT,   //< Held-Karp, small orders
+                E_ACO,     //< Ant colony (and local search)
+                E_GREEDY,  //< Nearest neighbour tour, no ant was constructed
+                E_CACHED   //< Same location set was solved before
+            };
+
         private:
             class WarehouseAnt_t
             {
@@ -42,25 +55,44 @@ namespace whm
 
                 public:
                     WarehouseAnt_t() = default;
+                    void reset(int32_t);
                     void visit(int32_t);
                     void setCost(int32_t);
-                    bool visited(int32_t);
+                    bool visited(int32_t) const;
                     int32_t getCost() const;
-                    std::vector<int32_t> getVisited() const;
+                    const std::vector<int32_t>& getVisited() const;
+
+                    // Counter-based random stream, depends only on the key
+                    void seed(uint64_t);
+                    double random();
 
                     bool operator<(const WarehouseAnt_t& rhs) const { return cost < rhs.cost; }
                     bool operator>(const WarehouseAnt_t& rhs) const { return cost > rhs.cost; }
 
                 private:
                     int32_t cost{ 0 };
-                    std::vector<int32_t> visitedLocations;
+                    std::vector<int32_t> visitedLocations; //< Tour, capacity is kept between resets
+                    std::vector<uint64_t> visitedMask;     //< Bit per location
+
+                    uint64_t randomKey{ 0 };
+                    uint64_t randomCounter{ 0 };
             };
 
         public:
+            /// Smaller orders are not worth of waking up other threads
+            static constexpr int32_t E_MIN_PARALLEL_DIMENSION = 64;
+
+            /// Memory of exact solver grows with 2^n * n
+            static constexpr int32_t E_MAX_EXACT_SIZE = 20;
+
             WarehousePathFinderACO_t(const utils::WhmArgs_t&);
             WarehousePathFinderACO_t(const utils::WhmArgs_t&, const ConfigParser_t&);
             virtual ~WarehousePathFinderACO_t();
 
+            /// New solver sharing configuration, precalculated paths and tour cache, solver state is not copied
+            WarehousePathFinderACO_t(const WarehousePathFinderACO_t&);
+            WarehousePathFinderACO_t& operator=(const WarehousePathFinderACO_t&) = delete;
+
             // Rand
             double randomFromInterval(double, double);
             int32_t randomFromInterval(int32_t, int32_t);
@@ -70,11 +102,12 @@ namespace whm
             void findLocationsToVisit();
             std::vector<int32_t> findNearestNeighbours(int32_t);
 
-            // Selection
-            int32_t rouletteSelection(double, std::vector<double> const&);
+            // Selection, -1 when all nearest neighbours are visited
+            int32_t rouletteSelection(WarehouseAnt_t&, int32_t);
 
             // Ant actions
             bool performNextAntStep(WarehouseAnt_t&);
+            void constructAnts(int32_t);
 
             // Callbacks
 #           ifdef WHM_GUI
@@ -101,6 +134,7 @@ namespace whm
             void initPheromones();
             void evaporation(double);
             void deposit(int32_t, int32_t, double);
+            void updateChoiceWeights();
 
             // Clearing
             void clearPathFinder();
@@ -118,6 +152,20 @@ namespace whm
             void calcStats() override;
 
         protected:
+            void solve();
+            bool findCachedTour();
+            void cacheBestTour();
+            WarehouseTourCache_t::Key_t getTourKey() const;
+            void solveExact();
+            void solveColony(bool);
+            int32_t getInteriorCount() const;
+
+            // Local search of fixed start/finish tour
+            void setBestTour(const std::vector<int32_t>&);
+            void improveBestTour();
+
+            void writeStats(std::ostream&, size_t, int32_t, int32_t, double, SolverType_t) const;
+
             std::mt19937 rand;
             ConfigParser_t cfg;
             utils::WhmArgs_t args;
@@ -125,6 +173,7 @@ namespace whm
             int32_t whStart{ 0 };
             int32_t whFinish{ 0 };
             int32_t dimension{ 0 };
+            int32_t selectedOrderID{ 0 };
 
             double probBest{ 0. };
             double pheromoneMax{ 0. };
@@ -133,18 +182,34 @@ namespace whm
             std::vector<int32_t> results;
             std::vector<int32_t> locations;
 
-            std::vector<std::vector<double>> heuristics;
-            std::vector<std::vector<double>> edgePheromones;
+            WarehouseMatrix_t<double> heuristics;
+            WarehouseMatrix_t<double> edgePheromones;
 
-            std::vector<std::vector<int32_t>> distances;
+            WarehouseMatrix_t<int32_t> distances;
             std::vector<std::vector<int32_t>> nearestNeighbours;
 
+            // Pheromone * heuristic of nearest neighbours (row per location, column per neighbour)
+            // and their running sums, refreshed after each pheromone update
+            WarehouseMatrix_t<double> choiceWeights;
+            WarehouseMatrix_t<double> choiceSums;
+
 #           ifdef WHM_GUI
             UiCallback_t uiCallback;
 #           endif
 
             WarehouseAnt_t bestWhAnt;
             std::vector<WarehouseAnt_t> whAnts;
+
+            uint64_t searchSeed{ 0 };  //< Ant streams of one search are derived from it
+            std::unique_ptr<WarehouseThreadPool_t> threadPool;
+
+            SolverType_t solver{ SolverType_t::E_ACO };  //< Solver of the last order
+
+            // Held-Karp tables, kept between orders
+            std::vector<int32_t> exactCosts;
+            std::vector<int8_t> exactParents;
+
+            std::shared_ptr<WarehouseTourCache_t> tourCache;  //< Shared by copies, null when disabled
     };
 }
 
@@ -10,20 +10,94 @@
 #ifdef WHM_SIM
 
 // Std
+#include <cmath>
 #include <chrono>
+#include <cstdio>
+#include <sstream>
 #include <thread>
 #include <limits>
 #include <utility>
 #include <iostream>
 #include <algorithm>
+#include <sys/wait.h>
 
 // Local
 #include "Logger.h"
 #include "WarehouseItem.h"
+#include "WarehouseArticles.h"
 #include "WarehouseSimulatorSIMLIB.h"
 
 namespace whm
 {
+    namespace
+    {
+        /**
+         * @brief Linearly interpolated q-quantile of ascending sorted values
+         */
+        double percentile(const std::vector<double>& sorted, double q)
+        {
+            if(sorted.empty())
+            {
+                return 0.0;
+            }
+
+            const double pos = q * (sorted.size() - 1);
+            const size_t lo = static_cast<size_t>(pos);
+            const size_t hi = std::min(lo + 1, sorted.size() - 1);
+
+            return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+        }
+
+        /**
+         * @brief Quantile of standard normal distribution (bisection of its CDF)
+         */
+        double normalQuantile(double p)
+        {
+            double lo{ -10.0 };
+            double hi{ 10.0 };
+
+            for(int32_t i = 0; i < 100; ++i)
+            {
+                const double mid = (lo + hi) / 2;
+
+                if(0.5 * std::erfc(-mid / std::sqrt(2.0)) < p)
+                {
+                    lo = mid;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+
+            return (lo + hi) / 2;
+        }
+
+        /**
+         * @brief Quantile of Student's t-distribution, exact for 1 and 2 degrees of freedom,
+         *        Cornish-Fisher expansion otherwise
+         */
+        double studentQuantile(double p, int32_t dof)
+        {
+            if(dof == 1)
+            {
+                return std::tan(M_PI * (p - 0.5));
+            }
+            else if(dof == 2)
+            {
+                return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+            }
+
+            const double z = normalQuantile(p);
+            const double n = dof;
+
+            return z + (std::pow(z, 3) + z) / (4 * n)
+                     + (5 * std::pow(z, 5) + 16 * std::pow(z, 3) + 3 * z) / (96 * n * n)
+                     + (3 * std::pow(z, 7) + 19 * std::pow(z, 5) + 17 * std::pow(z, 3) - 15 * z) / (384 * n * n * n)
+                     + (79 * std::pow(z, 9) + 776 * std::pow(z, 7) + 1482 * std::pow(z, 5) - 1920 * std::pow(z, 3) - 945 * z) / (92160 * n * n * n * n);
+        }
+    }
+
     WarehouseSimulatorSIMLIB_t::WarehouseSimulatorSIMLIB_t()
         : showStats{ true }
         , optimizationMode{ false }
@@ -33,7 +107,9 @@ namespace whm
         , whLayout{ WarehouseLayout_t::getWhLayout() }
         , whOrders{ whLayout.getWhOrders() }
     {
-        whPathFinder->precalculatePaths(whLayout.getWhItems());
+        lineSequenceOffsets.reserve(whOrders.size() + 1);
+
+        whPathFinder->sharePaths(whLayout.getWhPathFinder());
 
         if(Logger_t::getLogger().isVerbose())
         {
@@ -56,13 +132,51 @@ namespace whm
         return whFacilities[facilityID];
     }
 
-    const std::vector<WarehouseOrder_t>& WarehouseSimulatorSIMLIB_t::getWhOrders() const
+    const WarehouseOrderBook_t& WarehouseSimulatorSIMLIB_t::getWhOrders() const
     {
         return whOrders;
     }
 
+    OrderLineSequence_t WarehouseSimulatorSIMLIB_t::getWhOrderSequence(size_t orderIdx) const
+    {
+        OrderLineSequence_t sequence;
+
+        sequence.first = lineSequence.data() + lineSequenceOffsets[orderIdx];
+        sequence.last  = lineSequence.data() + lineSequenceOffsets[orderIdx + 1];
+
+        return sequence;
+    }
+
+    bool WarehouseSimulatorSIMLIB_t::batchingActive() const
+    {
+        return batching;
+    }
+
+    size_t WarehouseSimulatorSIMLIB_t::getWhReleaseCount() const
+    {
+        return batching ? batchOrderCounts.size() : whOrders.size();
+    }
+
+    size_t WarehouseSimulatorSIMLIB_t::getWhBatchOrderCount(size_t batchIdx) const
+    {
+        return batchOrderCounts[batchIdx];
+    }
+
+    BatchLineSequence_t WarehouseSimulatorSIMLIB_t::getWhBatchSequence(size_t batchIdx) const
+    {
+        BatchLineSequence_t sequence;
+
+        sequence.first = batchSequence.data() + batchSequenceOffsets[batchIdx];
+        sequence.last  = batchSequence.data() + batchSequenceOffsets[batchIdx + 1];
+
+        return sequence;
+    }
+
     WarehouseSimulatorSIMLIB_t::~WarehouseSimulatorSIMLIB_t()
     {
+        processorPool.reset();
+        OrderProcessor_t::setPool(nullptr);
+
         delete whPathFinder;
         delete whPathFinderAco;
 
@@ -72,10 +186,14 @@ namespace whm
         }
 
         whFacilities.clear();
+        nodeFacilities.clear();
     }
 
     void WarehouseSimulatorSIMLIB_t::prepareWhSimulation()
     {
+        // Facilities get replaced, graph nodes are mapped to them again on the next congestion aware route
+        nodeFacilities.clear();
+
         for(const auto* whItem : whLayout.getWhItems())
         {
             auto whItemID = whItem->getWhItemID();
@@ -90,45 +208,85 @@ namespace whm
                 whFacilities[whItemID] = new simlib3::Store(std::to_string(whItemID).c_str(), cfg.getAs<int32_t>("conveyorCapacity"));
             }
         }
+
+        if(cfg.isSet("telemetry") && cfg.getAs<bool>("telemetry"))
+        {
+            telemetry.init(whFacilities, cfg.getAs<int32_t>("telemetrySamples"), cfg.getAs<double>("telemetryPeriod"));
+        }
     }
 
-    void WarehouseSimulatorSIMLIB_t::normalPreprocessing()
+    void WarehouseSimulatorSIMLIB_t::exportTelemetry()
     {
-        whOrders.clear();
-        whOrders = whLayout.getWhOrders();
-
-        using Loc_t = std::pair<int32_t, int32_t>;
+        std::string telemetryPath = cfg.getAs<std::string>("telemetryPath");
 
-        int32_t whEntranceID = lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_ENTRANCE)->getWhItemID();
+        // Each replication / what-if scenario has its own file
+        if(replication >= 0)
+        {
+            telemetryPath += "." + std::to_string(replication);
+        }
+        else if(scenario >= 0)
+        {
+            telemetryPath += ".scenario" + std::to_string(scenario);
+        }
 
-        for(auto& order : whOrders)
+        if(cfg.getAs<std::string>("telemetryFormat") == "binary")
+        {
+            telemetry.exportBinary(telemetryPath);
+        }
+        else
         {
-            std::vector<WarehouseOrderLine_t> newLines;
+            telemetry.exportCsv(telemetryPath);
+        }
+    }
 
-            /*for(auto itLine = order.begin(); itLine != order.end(); ++itLine)
-            {
-                auto itTargetLine = std::find_if(newLines.begin(), newLines.end(),
-                                                 [&](const WarehouseOrderLine_t& line) -> bool
-                                                 {
-                                                    return utils::intersects(lookupWhLocations(line.getArticle(), 0),
-                                                                             lookupWhLocations(itLine->getArticle(), 0));
-                                                 });
+    void WarehouseSimulatorSIMLIB_t::appendOrderSequence(const WarehouseOrderBook_t::Order_t& order, const std::vector<int32_t>& locations)
+    {
+        const auto lines = order.getWhOrderLines();
 
-                if(itTargetLine != newLines.end())
-                {
-                    newLines.insert(itTargetLine, *itLine);
-                }
-                else
+        for(const auto& locID : locations)
+        {
+            for(size_t i = 0; i < lines.size(); ++i)
+            {
+                if(utils::contains(lookupWhLocations(lines[i].getArticleID(), 0), locID))
                 {
-                    newLines.push_back(*itLine);
+                    lineSequence.push_back(static_cast<int32_t>(i));
                 }
-            }*/
+            }
+        }
+
+        lineSequenceOffsets.push_back(lineSequence.size());
+    }
+
+    void WarehouseSimulatorSIMLIB_t::noPreprocessing()
+    {
+        for(const auto& order : whOrders)
+        {
+            for(size_t i = 0; i < order.getWhOrderLines().size(); ++i)
+            {
+                lineSequence.push_back(static_cast<int32_t>(i));
+            }
+
+            lineSequenceOffsets.push_back(lineSequence.size());
+        }
+    }
+
+    void WarehouseSimulatorSIMLIB_t::normalPreprocessing()
+    {
+        using Loc_t = std::pair<int32_t, int32_t>;
+
+        int32_t whEntranceID = lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_ENTRANCE)->getWhItemID();
 
-            std::vector<Loc_t> locations;
+        std::vector<Loc_t> locations;
+        std::vector<int32_t> sortedLocations;
+
+        for(const auto& order : whOrders)
+        {
+            locations.clear();
+            sortedLocations.clear();
 
             for(const auto& line : order)
             {
-                int32_t locationID = lookupWhLocations(line.getArticle(), 0).at(0);
+                int32_t locationID = lookupWhLocations(line.getArticleID(), 0).at(0);
 
                 auto it = std::find_if(locations.begin(), locations.end(),
                                        [=](const Loc_t& loc) -> bool
@@ -155,58 +313,43 @@ namespace whm
 
             for(const auto& loc : locations)
             {
-                for(const auto& line : order)
-                {
-                    if(utils::contains(lookupWhLocations(line.getArticle(), 0), loc.first))
-                    {
-                        newLines.push_back(line);
-                    }
-                }
+                sortedLocations.push_back(loc.first);
             }
 
-            // Fix broken IDs
-            for(auto itLine = newLines.begin(); itLine != newLines.end(); ++itLine)
-            {
-                itLine->setWhLineID(itLine - newLines.begin() /*+ 1*/);
-            }
-
-            order.setWhOrderLines(newLines);
+            appendOrderSequence(order, sortedLocations);
         }
     }
 
     void WarehouseSimulatorSIMLIB_t::optimizedPreprocessing()
     {
-        whOrders.clear();
-        whOrders = whLayout.getWhOrders();
-
         for(size_t i = 0; i < whOrders.size(); ++i)
         {
-            auto& order = whOrders.at(i);
-
-            std::vector<WarehouseOrderLine_t> newLines;
-
             const auto& bestPath = whPathFinderAco->findPath(static_cast<int32_t>(i));
 
             // Erase first and last node from bestPath (entrance/exit)?
 
-            for(const auto& locID : bestPath)
-            {
-                for(const auto& line : order)
-                {
-                    if(utils::contains(lookupWhLocations(line.getArticle(), 0), locID))
-                    {
-                        newLines.push_back(line);
-                    }
-                }
-            }
+            appendOrderSequence(whOrders.at(i), bestPath);
+        }
+    }
 
-            // Fix broken IDs
-            for(auto itLine = newLines.begin(); itLine != newLines.end(); ++itLine)
-            {
-                itLine->setWhLineID(itLine - newLines.begin() /*+ 1*/);
-            }
+    void WarehouseSimulatorSIMLIB_t::batchPreprocessing()
+    {
+        if(!whOrderBatcher)
+        {
+            whOrderBatcher = std::make_unique<WarehouseOrderBatcher_t>(*whPathFinder, cfg);
+        }
 
-            order.setWhOrderLines(newLines);
+        const auto& batches = whOrderBatcher->createBatches(whOrders,
+                                                            lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_ENTRANCE)->getWhItemID(),
+                                                            lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_DISPATCH)->getWhItemID());
+
+        for(const auto& batch : batches)
+        {
+            const auto pickLines = whOrderBatcher->getPickLines(batch);
+
+            batchSequence.insert(batchSequence.end(), pickLines.begin(), pickLines.end());
+            batchSequenceOffsets.push_back(batchSequence.size());
+            batchOrderCounts.push_back(batch.orders.size());
         }
     }
 
@@ -226,6 +369,37 @@ namespace whm
         passivatedProcesses[locID].clear();
     }
 
+    void WarehouseSimulatorSIMLIB_t::failItem(int32_t whItemID)
+    {
+        failedItems.insert(whItemID);
+    }
+
+    void WarehouseSimulatorSIMLIB_t::repairItem(int32_t whItemID)
+    {
+        failedItems.erase(whItemID);
+        activateProcesses(whItemID);
+    }
+
+    bool WarehouseSimulatorSIMLIB_t::isItemFailed(int32_t whItemID) const
+    {
+        return failedItems.find(whItemID) != failedItems.end();
+    }
+
+    WarehouseOrder_t& WarehouseSimulatorSIMLIB_t::acquireReplenishmentOrder()
+    {
+        if(replenishmentOrdersUsed == replenishmentOrders.size())
+        {
+            replenishmentOrders.emplace_back();
+        }
+
+        WarehouseOrder_t& replenishment = replenishmentOrders.at(replenishmentOrdersUsed++);
+
+        replenishment.clearWhOrderLines();
+        replenishment.setWhOrderType(WarehouseOrderType_t::E_REPLENISHMENT_ORDER);
+
+        return replenishment;
+    }
+
     double WarehouseSimulatorSIMLIB_t::runSimulation()
     {
         if(cfg.getAs<bool>("replenishment"))
@@ -244,7 +418,7 @@ namespace whm
         {
             prepareWhSimulation();
 
-            if(optimizationModeActive())
+            if(optimizationModeActive() || stochastic)
             {
                 multipleExperiments = !multipleExperiments;
             }
@@ -253,7 +427,31 @@ namespace whm
         // Perform order preprocessing
         //    We need to do preprocessing in each simulation run, since optimizer moves products between
         //    locations, so the previous calculated optimal path may no longer be optimal
-        if(cfg.getAs<std::string>("preprocessing") == "normal")
+        lineSequence.clear();
+        lineSequenceOffsets.clear();
+        lineSequenceOffsets.push_back(0);
+        batchSequence.clear();
+        batchSequenceOffsets.clear();
+        batchSequenceOffsets.push_back(0);
+        batchOrderCounts.clear();
+        cycleTimes.clear();
+
+        batching = cfg.isSet("batching") && cfg.getAs<bool>("batching");
+
+        congestionRouting = cfg.isSet("routing") && cfg.getAs<std::string>("routing") == "congestion";
+
+        if(congestionRouting)
+        {
+            congestionWeight = cfg.getAs<double>("congestionWeight");
+            routingMaxExpansions = static_cast<size_t>(std::max(cfg.getAs<int32_t>("routingMaxExpansions"), 0));
+        }
+
+        if(batching)
+        {
+            // Batches are picked in order of their tours, lines of single orders are not needed
+            batchPreprocessing();
+        }
+        else if(cfg.getAs<std::string>("preprocessing") == "normal")
         {
             normalPreprocessing();
         }
@@ -261,19 +459,414 @@ namespace whm
         {
             optimizedPreprocessing();
         }
+        else
+        {
+            noPreprocessing();
+        }
 
         //SetCalendar("cq");
         Init(0);
         clearSimulation();
+
+        if(stochastic)
+        {
+            RandomSeed(cfg.getAs<int32_t>("replicationSeed") + replication);
+        }
+
+        OrderProcessor_t::setPool(&processorPool);
         (new OrderRequest_t(*this))->Activate();
+
+        if(telemetry.isEnabled())
+        {
+            telemetry.reset();
+            (new TelemetrySampler_t(telemetry))->Activate(Time + telemetry.getPeriod());
+        }
+
+        if(replication < 0 && cfg.isSet("whatIf") && cfg.getAs<bool>("whatIf"))
+        {
+            (new CheckpointEvent_t(*this))->Activate(Time + cfg.getAs<double>("checkpointTime"));
+        }
+
         Run();
 
+        if(telemetry.isEnabled())
+        {
+            exportTelemetry();
+        }
+
+        if(scenario >= 0)
+        {
+            finishScenario();
+        }
+
         return Time;
     }
 
-    void WarehouseSimulatorSIMLIB_t::orderFinished(double duration, int32_t distanceConv, int32_t distanceWorker)
+    void WarehouseSimulatorSIMLIB_t::runReplications()
+    {
+        const int32_t replications = cfg.getAs<int32_t>("replications");
+        int32_t procCount = cfg.getAs<int32_t>("replicationProcs");
+
+        if(procCount <= 0)
+        {
+            procCount = static_cast<int32_t>(std::thread::hardware_concurrency());
+        }
+
+        procCount = std::max(1, std::min(procCount, replications));
+
+        stochastic = true;
+        showStats = false;
+
+        // SIMLIB keeps its calendar in globals, so replications run in separate processes
+        std::vector<std::pair<pid_t, int32_t>> replicationProcesses;
+
+        std::cout.flush();
+        fflush(stdout);
+
+        for(int32_t i = 0; i < procCount; ++i)
+        {
+            int fd[2];
+
+            if(pipe(fd))
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Pipe failed");
+                throw std::runtime_error("Pipe failed");
+            }
+
+            pid_t pid = fork();
+
+            if(pid < 0)
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Fork failed <%d>", errno);
+                throw std::runtime_error("Fork failed");
+            }
+            else if(pid != 0)
+            {
+                close(fd[1]);
+
+                replicationProcesses.emplace_back(pid, fd[0]);
+            }
+            else
+            {
+                close(fd[0]);
+
+                for(auto& replicationProcess : replicationProcesses)
+                {
+                    close(replicationProcess.second);
+                }
+
+                replicationService(i, procCount, fd[1]);
+            }
+        }
+
+        std::vector<ReplicationResult_t> results;
+        results.reserve(replications);
+
+        for(auto& replicationProcess : replicationProcesses)
+        {
+            ReplicationResult_t result;
+
+            for(;;)
+            {
+                auto s = read(replicationProcess.second, &result, sizeof(ReplicationResult_t));
+
+                if(s == 0)
+                {
+                    break;
+                }
+                else if(s < (ssize_t)sizeof(ReplicationResult_t))
+                {
+                    Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Read failed <%d>", errno);
+                    throw std::runtime_error("Read failed");
+                }
+
+                results.push_back(result);
+            }
+
+            close(replicationProcess.second);
+            waitpid(replicationProcess.first, nullptr, 0);
+        }
+
+        if(results.size() != static_cast<size_t>(replications))
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Finished <%d> of <%d> replications", static_cast<int32_t>(results.size()), replications);
+            throw std::runtime_error("Replication failed");
+        }
+
+        reportReplications(results);
+    }
+
+    void WarehouseSimulatorSIMLIB_t::replicationService(int32_t first, int32_t step, int32_t outfd)
+    {
+        const int32_t replications = cfg.getAs<int32_t>("replications");
+
+        for(int32_t r = first; r < replications; r += step)
+        {
+            replication = r;
+
+            runSimulation();
+
+            ReplicationResult_t result = replicationResult(r);
+
+            auto s = write(outfd, &result, sizeof(ReplicationResult_t));
+
+            if(s < (ssize_t)sizeof(ReplicationResult_t))
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Write failed <%d>", errno);
+                throw std::runtime_error("Write failed");
+            }
+        }
+
+        close(outfd);
+
+        // Static destructors belong to the parent (e.g. logger would wait for its flusher thread)
+        Logger_t::getLogger().flush();
+        _exit(0);
+    }
+
+    WarehouseSimulatorSIMLIB_t::ReplicationResult_t WarehouseSimulatorSIMLIB_t::replicationResult(int32_t r)
+    {
+        ReplicationResult_t result;
+
+        std::sort(cycleTimes.begin(), cycleTimes.end());
+
+        result.replication  = r;
+        result.makespan     = Time;
+        result.throughput   = Time > 0 ? cycleTimes.size() / Time * 3600 : 0.0;
+        result.cycleTimeP50 = percentile(cycleTimes, 0.50);
+        result.cycleTimeP90 = percentile(cycleTimes, 0.90);
+        result.cycleTimeP95 = percentile(cycleTimes, 0.95);
+
+        return result;
+    }
+
+    void WarehouseSimulatorSIMLIB_t::reportReplications(std::vector<ReplicationResult_t>& results) const
+    {
+        std::sort(results.begin(), results.end(),
+                  [](const ReplicationResult_t& lhs, const ReplicationResult_t& rhs) -> bool
+                  {
+                      return lhs.replication < rhs.replication;
+                  });
+
+        for(const auto& result : results)
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "Replication <%d>: makespan <%f>, throughput <%f>, cycle time p50 <%f> p90 <%f> p95 <%f>",
+                                        result.replication, result.makespan, result.throughput, result.cycleTimeP50, result.cycleTimeP90, result.cycleTimeP95);
+        }
+
+        const double confidence = cfg.getAs<double>("confidenceLevel");
+        const int32_t n = static_cast<int32_t>(results.size());
+        const double t = n > 1 ? studentQuantile((1 + confidence) / 2, n - 1) : 0.0;
+
+        auto report = [&](const char* name, double ReplicationResult_t::* metric)
+        {
+            double mean{ 0.0 };
+            double variance{ 0.0 };
+
+            for(const auto& result : results)
+            {
+                mean += result.*metric;
+            }
+
+            mean /= n;
+
+            for(const auto& result : results)
+            {
+                variance += (result.*metric - mean) * (result.*metric - mean);
+            }
+
+            variance = n > 1 ? variance / (n - 1) : 0.0;
+
+            const double halfWidth = t * std::sqrt(variance / n);
+
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, " %s <%f> +- <%f> [<%f>, <%f>]", name, mean, halfWidth, mean - halfWidth, mean + halfWidth);
+        };
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "=====================================================");
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, " Replications:                     [-] <%d>, confidence <%f>", n, confidence);
+        report("Makespan:                         [s]", &ReplicationResult_t::makespan);
+        report("Throughput:                 [orders/h]", &ReplicationResult_t::throughput);
+        report("Cycle time p50:                   [s]", &ReplicationResult_t::cycleTimeP50);
+        report("Cycle time p90:                   [s]", &ReplicationResult_t::cycleTimeP90);
+        report("Cycle time p95:                   [s]", &ReplicationResult_t::cycleTimeP95);
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "=====================================================");
+    }
+
+    void WarehouseSimulatorSIMLIB_t::forkScenarios()
+    {
+        std::vector<std::string> scenarios;
+        std::stringstream scenarioStream(cfg.getAs<std::string>("whatIfScenarios"));
+        std::string scenarioSpec;
+
+        while(std::getline(scenarioStream, scenarioSpec, ';'))
+        {
+            scenarios.push_back(scenarioSpec);
+        }
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "Checkpoint at <%f>, forking <%d> what-if scenarios", Time, static_cast<int32_t>(scenarios.size()));
+
+        std::vector<std::pair<pid_t, int32_t>> scenarioProcesses;
+
+        std::cout.flush();
+        fflush(stdout);
+
+        for(size_t i = 0; i < scenarios.size(); ++i)
+        {
+            int fd[2];
+
+            if(pipe(fd))
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Pipe failed");
+                throw std::runtime_error("Pipe failed");
+            }
+
+            pid_t pid = fork();
+
+            if(pid < 0)
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Fork failed <%d>", errno);
+                throw std::runtime_error("Fork failed");
+            }
+            else if(pid != 0)
+            {
+                close(fd[1]);
+
+                scenarioProcesses.emplace_back(pid, fd[0]);
+            }
+            else
+            {
+                close(fd[0]);
+
+                for(auto& scenarioProcess : scenarioProcesses)
+                {
+                    close(scenarioProcess.second);
+                }
+
+                // Child continues from the snapshot, results are sent to parent once simulation finishes
+                scenario = static_cast<int32_t>(i);
+                scenarioOutfd = fd[1];
+                showStats = false;
+
+                applyScenario(scenarios[i]);
+
+                return;
+            }
+        }
+
+        std::vector<ReplicationResult_t> results;
+
+        for(auto& scenarioProcess : scenarioProcesses)
+        {
+            ReplicationResult_t result;
+
+            auto s = read(scenarioProcess.second, &result, sizeof(ReplicationResult_t));
+
+            if(s == (ssize_t)sizeof(ReplicationResult_t))
+            {
+                results.push_back(result);
+            }
+            else
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Scenario process <%d> did not finish", static_cast<int32_t>(scenarioProcess.first));
+            }
+
+            close(scenarioProcess.second);
+            waitpid(scenarioProcess.first, nullptr, 0);
+        }
+
+        reportScenarios(scenarios, results);
+
+        // Prefix of the run is shared by all scenarios, parent does not continue on its own
+        Stop();
+    }
+
+    void WarehouseSimulatorSIMLIB_t::applyScenario(const std::string& scenarioSpec)
     {
-        stats.outboundsFinished++;
+        std::stringstream actionStream(scenarioSpec);
+        std::string action;
+
+        // Actions separated by ',':
+        //    none                      - continue unchanged
+        //    reslot:<locations.csv>    - import new article-slot allocation
+        //    fail:<item ID>:<duration> - facility is blocked for given time
+        while(std::getline(actionStream, action, ','))
+        {
+            std::vector<std::string> tokens;
+            std::stringstream tokenStream(action);
+            std::string token;
+
+            while(std::getline(tokenStream, token, ':'))
+            {
+                tokens.push_back(token);
+            }
+
+            if(tokens.empty() || tokens.at(0) == "none")
+            {
+                continue;
+            }
+            else if(tokens.at(0) == "reslot" && tokens.size() == 2)
+            {
+                whLayout.importLocationSlots(tokens.at(1));
+            }
+            else if(tokens.at(0) == "fail" && tokens.size() == 3)
+            {
+                (new FailureProcess_t(std::stoi(tokens.at(1)), std::stod(tokens.at(2)), *this))->Activate();
+            }
+            else
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Unknown what-if action <%s>", action.c_str());
+                throw std::runtime_error("Unknown what-if action");
+            }
+        }
+    }
+
+    void WarehouseSimulatorSIMLIB_t::finishScenario()
+    {
+        ReplicationResult_t result = replicationResult(scenario);
+
+        auto s = write(scenarioOutfd, &result, sizeof(ReplicationResult_t));
+
+        if(s < (ssize_t)sizeof(ReplicationResult_t))
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Write failed <%d>", errno);
+        }
+
+        close(scenarioOutfd);
+
+        Logger_t::getLogger().flush();
+        _exit(0);
+    }
+
+    void WarehouseSimulatorSIMLIB_t::reportScenarios(const std::vector<std::string>& scenarios, std::vector<ReplicationResult_t>& results) const
+    {
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "=====================================================");
+
+        for(const auto& result : results)
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, " Scenario <%s>: makespan <%f>, throughput <%f>, cycle time p50 <%f> p90 <%f> p95 <%f>",
+                                        scenarios.at(result.replication).c_str(), result.makespan, result.throughput,
+                                        result.cycleTimeP50, result.cycleTimeP90, result.cycleTimeP95);
+        }
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "=====================================================");
+    }
+
+    double WarehouseSimulatorSIMLIB_t::sampleServiceTime(double mean) const
+    {
+        return stochastic ? Exponential(mean) : mean;
+    }
+
+    double WarehouseSimulatorSIMLIB_t::sampleArrivalInterval() const
+    {
+        return sampleServiceTime(cfg.getAs<double>("orderRequestInterval"));
+    }
+
+    void WarehouseSimulatorSIMLIB_t::orderFinished(double duration, int32_t distanceConv, int32_t distanceWorker, size_t orderCount)
+    {
+        // All orders of a batch are shipped together
+        cycleTimes.insert(cycleTimes.end(), orderCount, duration);
+
+        stats.outboundsFinished += orderCount;
         stats.processingTime = duration;
         stats.distanceTraveledConv += distanceConv;
         stats.distanceTraveledWorker += distanceWorker;
@@ -337,6 +930,13 @@ namespace whm
         {
             whFacility.second->Clear();
         }
+
+        // Processes left from previous run (e.g. unfinished replenishments) are dropped here,
+        // orders they referenced can be reused afterwards
+        passivatedProcesses.clear();
+        failedItems.clear();
+        processorPool.reset();
+        replenishmentOrdersUsed = 0;
     }
 
     void WarehouseSimulatorSIMLIB_t::setArguments(const utils::WhmArgs_t& args_)
@@ -383,14 +983,71 @@ namespace whm
         return whPathInfo;
     }
 
+    WarehousePathInfo_t* WarehouseSimulatorSIMLIB_t::lookupShortestPath(int32_t currentLocID, const std::vector<int32_t>& targetLocIDs, WarehousePathInfo_t& route)
+    {
+        WarehousePathInfo_t* staticPath = lookupShortestPath(currentLocID, targetLocIDs);
+
+        if(!congestionRouting)
+        {
+            return staticPath;
+        }
+
+        const auto& whGraph = whLayout.getWhGraph();
+
+        if(nodeFacilities.empty())
+        {
+            nodeFacilities.assign(whGraph.getNodeCount(), nullptr);
+
+            for(uint32_t node = 0; node < whGraph.getNodeCount(); ++node)
+            {
+                auto it = whFacilities.find(whGraph.getWhItemID(node));
+
+                if(it != whFacilities.end())
+                {
+                    nodeFacilities[node] = it->second;
+                }
+            }
+        }
+
+        auto nodeCost = [this](uint32_t node) -> double
+                        {
+                            const simlib3::Store* whFacility = nodeFacilities[node];
+
+                            if(!whFacility)
+                            {
+                                return 1.0;
+                            }
+
+                            return 1.0 + congestionWeight * (whFacility->Used() + whFacility->QueueLen()) / static_cast<double>(whFacility->Capacity());
+                        };
+
+        // Search is bounded, static path is used when it gets too expensive
+        if(!whPathFinder->findRoute(whGraph, currentLocID, targetLocIDs, nodeCost, routingMaxExpansions, route))
+        {
+            return staticPath;
+        }
+
+        if(whPathFinder->pathDistance(route.pathToTarget) > whPathFinder->pathDistance(staticPath->pathToTarget))
+        {
+            ++ stats.congestionDetours;
+        }
+
+        return &route;
+    }
+
     std::vector<int32_t> WarehouseSimulatorSIMLIB_t::lookupWhLocations(const std::string& article, int32_t quantity)
+    {
+        return lookupWhLocations(WarehouseArticles_t::getWhArticles().lookup(article), quantity);
+    }
+
+    std::vector<int32_t> WarehouseSimulatorSIMLIB_t::lookupWhLocations(int32_t articleID, int32_t quantity)
     {
         std::vector<int32_t> whLocIDs;
 
         for(const auto* whItem : whLayout.getWhItems())
         {
             if(whItem->getType() == WarehouseItemType_t::E_LOCATION_SHELF &&
-               whItem->getWhLocationRack()->containsArticle(article, quantity))
+               whItem->getWhLocationRack()->containsArticle(articleID, quantity))
             {
                 whLocIDs.push_back(whItem->getWhItemID());
             }
@@ -435,6 +1092,11 @@ namespace whm
         Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, " Distance traveled (conveyor):     [m] <%d>", this->distanceTraveledConv);
         Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, " Distance traveled (workes):       [m] <%d>", this->distanceTraveledWorker);
         Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, " Simulation finished in:           [s] <%f>", this->processingTime);
+
+        if(this->congestionDetours)
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, " Detours around congestion:        [-] <%zu>", this->congestionDetours);
+        }
         Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "=====================================================");
     }
 
@@ -445,31 +1107,64 @@ namespace whm
         this->replenishmentsFinished    = 0;
         this->distanceTraveledConv      = 0;
         this->distanceTraveledWorker    = 0;
+        this->congestionDetours         = 0;
     }
 
     // ================================================================================================================
 
-    OrderProcessor_t::OrderProcessor_t(WarehouseOrder_t order_, WarehouseSimulatorSIMLIB_t& sim_)
-        : order(order_)
+    ObjectPool_t<OrderProcessor_t>* OrderProcessor_t::pool{ nullptr };
+
+    OrderProcessor_t::OrderProcessor_t(size_t orderIdx_, WarehouseSimulatorSIMLIB_t& sim_)
+        : orderIdx(orderIdx_)
         , sim(sim_)
     {
 
     }
 
+    OrderProcessor_t::OrderProcessor_t(const WarehouseOrder_t& order_, WarehouseSimulatorSIMLIB_t& sim_)
+        : orderIdx(std::numeric_limits<size_t>::max())
+        , replenishment(&order_)
+        , sim(sim_)
+    {
+
+    }
+
+    void* OrderProcessor_t::operator new(size_t size)
+    {
+        if(pool && size == sizeof(OrderProcessor_t))
+        {
+            return pool->allocate();
+        }
+
+        return ::operator new(size);
+    }
+
+    void OrderProcessor_t::operator delete(void* p, size_t)
+    {
+        if(pool && pool->owns(p))
+        {
+            pool->deallocate(p);
+        }
+        else
+        {
+            ::operator delete(p);
+        }
+    }
+
+    void OrderProcessor_t::setPool(ObjectPool_t<OrderProcessor_t>* pool_)
+    {
+        pool = pool_;
+    }
+
     void OrderProcessor_t::Behavior()
     {
-        switch(order.getWhOrderType())
+        if(replenishment)
         {
-            case whm::WarehouseOrderType_t::E_OUTBOUND_ORDER:
-            {
-                outboundProcessing();
-                break;
-            }
-            case whm::WarehouseOrderType_t::E_REPLENISHMENT_ORDER:
-            {
-                replenishmentProcessing();
-                break;
-            }
+            replenishmentProcessing();
+        }
+        else
+        {
+            outboundProcessing();
         }
     }
 
@@ -477,109 +1172,134 @@ namespace whm
     {
         simlib3::Store* whFacility = sim.getWhItemFacility(itemID);
 
+        // Failed item is not entered until repaired (processes waiting for replenishment share the queue, so check again)
+        while(sim.isItemFailed(itemID))
+        {
+            sim.passivateProcess(itemID, this);
+        }
+
         Enter(*whFacility, 1);
         Wait(waitDuration / sim.getConfig().getAs<double>("simSpeedup"));
         Leave(*whFacility, 1);
     }
 
-    void OrderProcessor_t::outboundProcessing()
+    void OrderProcessor_t::pickLine(const WarehouseOrderBook_t::Line_t& orderLine, int32_t& locationID, size_t& totalDistanceConv, size_t& totalDistanceWorker)
     {
-        int32_t locationID{ 0 };
         double waitDuration{ 0.0 };
-        double processDuration{ Time };
-        size_t totalDistanceConv{ 0 };
-        size_t totalDistanceWorker{ 0 };
 
-        // Simulate order start from entrance
-        locationID = sim.lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_ENTRANCE)->getWhItemID();
+        const std::vector<int32_t>& targetLocations = sim.lookupWhLocations(orderLine.getArticleID(), 0);
+        const WarehousePathInfo_t* shortestPath = sim.lookupShortestPath(locationID, targetLocations, route);
 
-        // Process all order lines
-        for(const WarehouseOrderLine_t& orderLine : order)
+        // Reach target location using conveyor
+        for(const std::pair<int32_t, int32_t>& pathItem : shortestPath->pathToTarget)
         {
-            const std::vector<int32_t>& targetLocations = sim.lookupWhLocations(orderLine.getArticle(), 0);
-            const WarehousePathInfo_t* shortestPath = sim.lookupShortestPath(locationID, targetLocations);
+            waitDuration = pathItem.second / sim.getConfig().getAs<double>("toteSpeed");
 
-            // Reach target location using conveyor
-            for(const std::pair<int32_t, int32_t>& pathItem : shortestPath->pathToTarget)
-            {
-                waitDuration = pathItem.second / sim.getConfig().getAs<double>("toteSpeed");
+            totalDistanceConv += pathItem.second;
 
-                totalDistanceConv += pathItem.second;
+            handleFacility(pathItem.first, waitDuration);
+        }
 
-                handleFacility(pathItem.first, waitDuration);
-            }
+        locationID = shortestPath->targetWhItemID;
 
-            locationID = shortestPath->targetWhItemID;
+        WarehouseItem_t* whLoc = sim.lookupWhLoc(locationID);
+        std::pair<size_t, size_t> slotPos;
+        bool containsProduct = whLoc->getWhLocationRack()->containsArticle(orderLine.getArticleID(), orderLine.getQuantity(), slotPos,
+                                                                           sim.getConfig().getAs<bool>("replenishment"));
 
-            WarehouseItem_t* whLoc = sim.lookupWhLoc(locationID);
-            std::pair<size_t, size_t> slotPos;
-            bool containsProduct = whLoc->getWhLocationRack()->containsArticle(orderLine.getArticle(), orderLine.getQuantity(), slotPos,
-                                                                               sim.getConfig().getAs<bool>("replenishment"));
+        if(sim.getConfig().getAs<bool>("replenishment") && !containsProduct)
+        {
+            // Create replenishment order and push to buffer / wait for reple to be processed
+            WarehouseOrder_t& replenishment = sim.acquireReplenishmentOrder();
 
-            if(sim.getConfig().getAs<bool>("replenishment") && !containsProduct)
+            // Fill replenishment with products we currently need at this location
+            auto* whRack = whLoc->getWhLocationRack();
+            for(int32_t y = 0; y < whRack->getSlotCountY(); y++)
             {
-                // Create replenishment order and push to buffer / wait for reple to be processed
-                WarehouseOrder_t replenishment;
-                std::vector<WarehouseOrderLine_t> replenishmentLines;
-                replenishment.setWhOrderType(WarehouseOrderType_t::E_REPLENISHMENT_ORDER);
-
-                // Fill replenishment with products we currently need at this location
-                auto* whRack = whLoc->getWhLocationRack();
-                for(int32_t y = 0; y < whRack->getSlotCountY(); y++)
+                for(int32_t x = 0; x < whRack->getSlotCountX(); x++)
                 {
-                    for(int32_t x = 0; x < whRack->getSlotCountX(); x++)
+                    if(whRack->at(x, y).getArticleID() == orderLine.getArticleID() ||
+                      (whRack->at(x, y).isOccupied() && whRack->at(x, y).getQuantity() <= sim.getConfig().getAs<int32_t>("replenishmentThreshold")))
                     {
-                        if(whRack->at(x, y).getArticle() == orderLine.getArticle() ||
-                          (whRack->at(x, y).isOccupied() && whRack->at(x, y).getQuantity() <= sim.getConfig().getAs<int32_t>("replenishmentThreshold")))
-                        {
-                            WarehouseOrderLine_t line(nullptr);
-                            line.setArticle(whRack->at(x, y).getArticle());
+                        WarehouseOrderLine_t line(nullptr);
+                        line.setArticle(whRack->at(x, y).getArticle());
 
-                            int32_t requestedQuantity{ 0 };
-
-                            if(whRack->at(x, y).getArticle() == orderLine.getArticle())
-                            {
-                                requestedQuantity = sim.getConfig().getAs<int32_t>("replenishmentQuantity") + orderLine.getQuantity();
-                            }
-                            else
-                            {
-                                requestedQuantity = sim.getConfig().getAs<int32_t>("replenishmentQuantity");
-                            }
+                        int32_t requestedQuantity{ 0 };
 
-                            line.setQuantity(requestedQuantity);
-                            replenishmentLines.emplace_back(std::move(line));
+                        if(whRack->at(x, y).getArticleID() == orderLine.getArticleID())
+                        {
+                            requestedQuantity = sim.getConfig().getAs<int32_t>("replenishmentQuantity") + orderLine.getQuantity();
+                        }
+                        else
+                        {
+                            requestedQuantity = sim.getConfig().getAs<int32_t>("replenishmentQuantity");
                         }
+
+                        line.setQuantity(requestedQuantity);
+                        replenishment.addWhOrderLine(std::move(line));
                     }
                 }
+            }
 
-                replenishment.setWhOrderLines(replenishmentLines);
+            (new OrderProcessor_t(replenishment, sim))->Activate();
 
-                (new OrderProcessor_t(replenishment, sim))->Activate();
+            // There might be multiple replenishmnent orders coming, so check if the product
+            // required by this order was replenished, and if not, deactivate the process again
+            while(!containsProduct)
+            {
+                // Night night
+                sim.passivateProcess(locationID, dynamic_cast<simlib3::Process*>(this));
+                containsProduct = whLoc->getWhLocationRack()->containsArticle(orderLine.getArticleID(), orderLine.getQuantity(), slotPos, true);
+            }
+        }
 
-                // There might be multiple replenishmnent orders coming, so check if the product
-                // required by this order was replenished, and if not, deactivate the process again
-                while(!containsProduct)
-                {
-                    // Night night
-                    sim.passivateProcess(locationID, dynamic_cast<simlib3::Process*>(this));
-                    containsProduct = whLoc->getWhLocationRack()->containsArticle(orderLine.getArticle(), orderLine.getQuantity(), slotPos, true);
-                }
+        // Pick article(s)
+        const auto ratio = WarehouseLayout_t::getWhLayout().getRatio();
+        const auto distance = ((slotPos.first  / static_cast<float>(whLoc->getWhLocationRack()->getSlotCountX())) * (whLoc->getW() / ratio) +
+                               (slotPos.second / static_cast<float>(whLoc->getWhLocationRack()->getSlotCountY())) * (whLoc->getH() / ratio));
+        totalDistanceWorker += distance;
+        waitDuration = sim.sampleServiceTime(distance / sim.getConfig().getAs<double>("workerSpeed"));
+
+        handleFacility(locationID, waitDuration);
+    }
+
+    void OrderProcessor_t::outboundProcessing()
+    {
+        int32_t locationID{ 0 };
+        double waitDuration{ 0.0 };
+        double processDuration{ Time };
+        size_t totalDistanceConv{ 0 };
+        size_t totalDistanceWorker{ 0 };
+        size_t orderCount{ 1 };
+
+        // Simulate order start from entrance
+        locationID = sim.lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_ENTRANCE)->getWhItemID();
+
+        if(sim.batchingActive())
+        {
+            // Lines of all orders of the batch, in order of its tour
+            for(const auto& batchLine : sim.getWhBatchSequence(orderIdx))
+            {
+                pickLine(sim.getWhOrders()[batchLine.orderIdx].getWhOrderLines()[batchLine.lineIdx], locationID, totalDistanceConv, totalDistanceWorker);
             }
 
-            // Pick article(s)
-            const auto ratio = WarehouseLayout_t::getWhLayout().getRatio();
-            const auto distance = ((slotPos.first  / static_cast<float>(whLoc->getWhLocationRack()->getSlotCountX())) * (whLoc->getW() / ratio) +
-                                   (slotPos.second / static_cast<float>(whLoc->getWhLocationRack()->getSlotCountY())) * (whLoc->getH() / ratio));
-            totalDistanceWorker += distance;
-            waitDuration = distance / sim.getConfig().getAs<double>("workerSpeed");
+            orderCount = sim.getWhBatchOrderCount(orderIdx);
+        }
+        else
+        {
+            // Process all order lines (in order given by preprocessing)
+            const auto orderLines = sim.getWhOrders()[orderIdx].getWhOrderLines();
 
-            handleFacility(locationID, waitDuration);
+            for(int32_t lineIdx : sim.getWhOrderSequence(orderIdx))
+            {
+                pickLine(orderLines[lineIdx], locationID, totalDistanceConv, totalDistanceWorker);
+            }
         }
 
         // Move the order/carton to shipping
         int32_t dispatchID = sim.lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_DISPATCH)->getWhItemID();
 
-        const WarehousePathInfo_t* shortestPath = sim.lookupShortestPath(locationID, std::vector<int32_t>{ dispatchID });
+        const WarehousePathInfo_t* shortestPath = sim.lookupShortestPath(locationID, std::vector<int32_t>{ dispatchID }, route);
 
         for(const std::pair<int32_t, int32_t>& pathItem : shortestPath->pathToTarget)
         {
@@ -593,12 +1313,12 @@ namespace whm
         // Ship order/carton
         locationID = dispatchID;
 
-        waitDuration = (60 / sim.getConfig().getAs<int32_t>("totesPerMin"));
+        waitDuration = sim.sampleServiceTime(60 / sim.getConfig().getAs<int32_t>("totesPerMin"));
 
         handleFacility(locationID, waitDuration);
 
-        // Trace finished order
-        sim.orderFinished(Time - processDuration, totalDistanceConv, totalDistanceWorker);
+        // Trace finished order (orders of the batch)
+        sim.orderFinished(Time - processDuration, totalDistanceConv, totalDistanceWorker, orderCount);
     }
 
     void OrderProcessor_t::replenishmentProcessing()
@@ -609,10 +1329,10 @@ namespace whm
         locationID = sim.lookupWhGate(WarehouseItemType_t::E_WAREHOUSE_BUFFER)->getWhItemID();
 
         // Process all replenishment order lines
-        for(const WarehouseOrderLine_t& orderLine : order)
+        for(const WarehouseOrderLine_t& orderLine : *replenishment)
         {
             const std::vector<int32_t>& targetLocations = sim.lookupWhLocations(orderLine.getArticle(), 0);
-            const WarehousePathInfo_t* shortestPath = sim.lookupShortestPath(locationID, targetLocations);
+            const WarehousePathInfo_t* shortestPath = sim.lookupShortestPath(locationID, targetLocations, route);
 
             // Reach target location using conveyor
             for(const std::pair<int32_t, int32_t>& pathItem : shortestPath->pathToTarget)
@@ -632,7 +1352,7 @@ namespace whm
             const auto waitDuration = ((slotPos.first  / static_cast<float>(whLoc->getWhLocationRack()->getSlotCountX())) * (whLoc->getW() / ratio) +
                                        (slotPos.second / static_cast<float>(whLoc->getWhLocationRack()->getSlotCountY())) * (whLoc->getH() / ratio)) / sim.getConfig().getAs<double>("workerSpeed");
 
-            handleFacility(locationID, waitDuration);
+            handleFacility(locationID, sim.sampleServiceTime(waitDuration));
         }
 
         // Replenishment finished, wake up sleeping processes (orders at location waiting for replenishment)
@@ -644,20 +1364,50 @@ namespace whm
 
     OrderRequest_t::OrderRequest_t(WarehouseSimulatorSIMLIB_t& sim_)
         : sim(sim_)
-        , it(sim.getWhOrders().begin())
     {
 
     }
 
     void OrderRequest_t::Behavior()
     {
-        (new OrderProcessor_t(*it, sim))->Activate();
+        // Order or batch of orders
+        (new OrderProcessor_t(orderIdx, sim))->Activate();
 
-        if(++it != sim.getWhOrders().end())
+        if(++orderIdx != sim.getWhReleaseCount())
         {
-            Activate(Time + /*Exponential*/(sim.getConfig().getAs<double>("orderRequestInterval")));
+            Activate(Time + sim.sampleArrivalInterval());
         }
     }
+
+    // ================================================================================================================
+
+    CheckpointEvent_t::CheckpointEvent_t(WarehouseSimulatorSIMLIB_t& sim_)
+        : sim(sim_)
+    {
+
+    }
+
+    void CheckpointEvent_t::Behavior()
+    {
+        sim.forkScenarios();
+    }
+
+    // ================================================================================================================
+
+    FailureProcess_t::FailureProcess_t(int32_t whItemID_, double duration_, WarehouseSimulatorSIMLIB_t& sim_)
+        : whItemID(whItemID_)
+        , duration(duration_)
+        , sim(sim_)
+    {
+
+    }
+
+    void FailureProcess_t::Behavior()
+    {
+        sim.failItem(whItemID);
+        Wait(duration);
+        sim.repairItem(whItemID);
+    }
 }
 
 #endif
@@ -13,13 +13,17 @@
 
 // Std
 #include <map>
+#include <deque>
+#include <memory>
 #include <functional>
+#include <unordered_set>
 
 // SIMLIB/C++
 #include <simlib.h>
 
 // Local
 #include "Utils.h"
+#include "ObjectPool.h"
 #include "ConfigParser.h"
 #include "WarehouseItem.h"
 #include "WarehouseOrder.h"
@@ -27,12 +31,73 @@
 #include "WarehouseTypes.h"
 #include "WarehousePathFinder.h"
 #include "WarehouseLocationRack.h"
+#include "WarehouseOrderBatcher.h"
 #include "WarehousePathFinderACO.h"
+#include "WarehouseSimulatorTelemetry.h"
 
 namespace whm
 {
     using PassivatedProcesses_t = std::map<int32_t, std::vector<simlib3::Process*>>;
 
+    class WarehouseSimulatorSIMLIB_t;
+
+    /**
+     * @brief Order lines of one order in the order they are visited (indices into order lines)
+     */
+    struct OrderLineSequence_t
+    {
+        const int32_t* first{ nullptr };
+        const int32_t* last{ nullptr };
+
+        const int32_t* begin() const { return first; }
+        const int32_t* end() const   { return last; }
+    };
+
+    /**
+     * @brief Order lines of one batch (pick wave) in the order they are visited
+     */
+    struct BatchLineSequence_t
+    {
+        using PickLine_t = WarehouseOrderBatcher_t::PickLine_t;
+
+        const PickLine_t* first{ nullptr };
+        const PickLine_t* last{ nullptr };
+
+        const PickLine_t* begin() const { return first; }
+        const PickLine_t* end() const   { return last; }
+    };
+
+    class OrderProcessor_t : public simlib3::Process
+    {
+        public:
+            OrderProcessor_t(size_t, WarehouseSimulatorSIMLIB_t&);
+            OrderProcessor_t(const WarehouseOrder_t&, WarehouseSimulatorSIMLIB_t&);
+
+            // Processes are recycled through the pool of currently running simulation
+            static void* operator new(size_t);
+            static void operator delete(void*, size_t);
+
+            static void setPool(ObjectPool_t<OrderProcessor_t>*);
+
+        protected:
+            void Behavior() override;
+            void outboundProcessing();
+            void replenishmentProcessing();
+
+            void handleFacility(int32_t, double);
+            void pickLine(const WarehouseOrderBook_t::Line_t&, int32_t&, size_t&, size_t&);
+
+        private:
+            size_t orderIdx;                                   //< Index of batch in batching mode
+            const WarehouseOrder_t* replenishment{ nullptr };
+            WarehouseSimulatorSIMLIB_t& sim;
+
+            WarehousePathInfo_t route;                         //< Path found for this tote when routing around congestion
+
+            static ObjectPool_t<OrderProcessor_t>* pool;
+    };
+
+
     class WarehouseSimulatorSIMLIB_t
     {
         public:
@@ -46,14 +111,30 @@ namespace whm
                 size_t replenishmentsFinished{ 0 };
                 size_t distanceTraveledConv{ 0 };
                 size_t distanceTraveledWorker{ 0 };
+                size_t congestionDetours{ 0 };
 
                 void dump() const;
                 void reset();
             };
 
+            /**
+             * @brief Results of one independent replication, sent from replication process to parent
+             */
+            struct ReplicationResult_t
+            {
+                int32_t replication{ 0 };
+                double makespan{ 0.0 };          //< Time when the last order was shipped [s]
+                double throughput{ 0.0 };        //< Shipped orders per hour [orders/h]
+                double cycleTimeP50{ 0.0 };      //< Median time from order release to shipping [s]
+                double cycleTimeP90{ 0.0 };
+                double cycleTimeP95{ 0.0 };
+            };
+
             double runSimulation();
+            void runReplications();
+            void forkScenarios();
             void replenishmentFinished();
-            void orderFinished(double, int32_t, int32_t);
+            void orderFinished(double, int32_t, int32_t, size_t = 1);
 
             void printStats(bool);
 
@@ -71,22 +152,53 @@ namespace whm
 #           endif
 
             simlib3::Store* getWhItemFacility(int32_t);
-            const std::vector<WarehouseOrder_t>& getWhOrders() const;
+            const WarehouseOrderBook_t& getWhOrders() const;
+            OrderLineSequence_t getWhOrderSequence(size_t) const;
+
+            // Batching mode, each process picks whole batch of orders
+            bool batchingActive() const;
+            size_t getWhReleaseCount() const;
+            size_t getWhBatchOrderCount(size_t) const;
+            BatchLineSequence_t getWhBatchSequence(size_t) const;
 
             WarehouseItem_t* lookupWhLoc(int32_t);
             WarehouseItem_t* lookupWhGate(const WarehouseItemType_t&);
+            std::vector<int32_t> lookupWhLocations(int32_t, int32_t);
             std::vector<int32_t> lookupWhLocations(const std::string&, int32_t);
             WarehousePathInfo_t* lookupShortestPath(int32_t, const std::vector<int32_t>&);
+            WarehousePathInfo_t* lookupShortestPath(int32_t, const std::vector<int32_t>&, WarehousePathInfo_t&);
 
             void passivateProcess(int32_t, simlib3::Process*);
             void activateProcesses(int32_t);
 
+            void failItem(int32_t);
+            void repairItem(int32_t);
+            bool isItemFailed(int32_t) const;
+
+            WarehouseOrder_t& acquireReplenishmentOrder();
+
+            double sampleServiceTime(double) const;
+            double sampleArrivalInterval() const;
+
         protected:
             void clearSimulation();
             void prepareWhSimulation();
+            void exportTelemetry();
 
+            void noPreprocessing();
             void normalPreprocessing();
             void optimizedPreprocessing();
+            void batchPreprocessing();
+
+            void appendOrderSequence(const WarehouseOrderBook_t::Order_t&, const std::vector<int32_t>&);
+
+            void replicationService(int32_t, int32_t, int32_t);
+            ReplicationResult_t replicationResult(int32_t);
+            void reportReplications(std::vector<ReplicationResult_t>&) const;
+
+            void applyScenario(const std::string&);
+            void finishScenario();
+            void reportScenarios(const std::vector<std::string>&, std::vector<ReplicationResult_t>&) const;
 
         private:
             bool showStats;
@@ -97,8 +209,9 @@ namespace whm
             UiCallback_t uiCallback;
 #           endif
 
-            // Processes (orders) waiting for replenishment @ location
+            // Processes (orders) waiting for replenishment @ location or for repair of failed item
             PassivatedProcesses_t passivatedProcesses;
+            std::unordered_set<int32_t> failedItems;
 
             ConfigParser_t cfg;
             utils::WhmArgs_t args;
@@ -107,42 +220,97 @@ namespace whm
             WarehousePathFinderACO_t* whPathFinderAco;
 
             WarehouseLayout_t& whLayout;
-            std::vector<WarehouseOrder_t> whOrders;
+            const WarehouseOrderBook_t& whOrders;
             std::map<int32_t, simlib3::Store*> whFacilities;
 
+            // Visit sequence of order lines written by preprocessing in each run, orders itself stay untouched
+            //    Lines of i-th order are stored in range <lineSequenceOffsets[i], lineSequenceOffsets[i + 1])
+            std::vector<int32_t> lineSequence;
+            std::vector<size_t> lineSequenceOffsets;
+
+            // Same for batches, lines of i-th batch are in <batchSequenceOffsets[i], batchSequenceOffsets[i + 1])
+            bool batching{ false };
+            std::unique_ptr<WarehouseOrderBatcher_t> whOrderBatcher;
+            std::vector<BatchLineSequence_t::PickLine_t> batchSequence;
+            std::vector<size_t> batchSequenceOffsets;
+            std::vector<size_t> batchOrderCounts;
+
+            // Congestion aware routing, conveyors are weighted by totes in and waiting for them
+            bool congestionRouting{ false };
+            double congestionWeight{ 0.0 };
+            size_t routingMaxExpansions{ 0 };
+            std::vector<simlib3::Store*> nodeFacilities;      //< Facility of each layout graph node
+
             SimulationStats_t stats;
+
+            // Replication mode (replications > 1), arrivals and service times are drawn from
+            // exponential distribution seeded per replication
+            bool stochastic{ false };
+            int32_t replication{ -1 };
+            std::vector<double> cycleTimes;
+
+            // What-if scenario continued by this process from checkpoint (-1 if none)
+            int32_t scenario{ -1 };
+            int32_t scenarioOutfd{ -1 };
+
+            // Per-facility time series, sampled only if enabled in configuration
+            WarehouseSimulatorTelemetry_t telemetry;
+
+            // Objects recycled between runs, so optimization does not hit global allocator for each order
+            ObjectPool_t<OrderProcessor_t> processorPool;
+            std::deque<WarehouseOrder_t> replenishmentOrders;
+            size_t replenishmentOrdersUsed{ 0 };
     };
 
 
-    class OrderProcessor_t : public simlib3::Process
+    class OrderRequest_t : public simlib3::Event
     {
         public:
-            OrderProcessor_t(WarehouseOrder_t, WarehouseSimulatorSIMLIB_t&);
+            OrderRequest_t(WarehouseSimulatorSIMLIB_t&);
 
         protected:
             void Behavior() override;
-            void outboundProcessing();
-            void replenishmentProcessing();
 
-            void handleFacility(int32_t, double);
+        private:
+            WarehouseSimulatorSIMLIB_t& sim;
+            size_t orderIdx{ 0 };
+    };
+
+
+    /**
+     * @brief Snapshot of the running simulation, whole process (calendar, queues, racks, orders in flight)
+     *        is forked and each child continues with one what-if scenario
+     */
+    class CheckpointEvent_t : public simlib3::Event
+    {
+        public:
+            CheckpointEvent_t(WarehouseSimulatorSIMLIB_t&);
+
+        protected:
+            void Behavior() override;
 
         private:
-            WarehouseOrder_t order;
             WarehouseSimulatorSIMLIB_t& sim;
     };
 
 
-    class OrderRequest_t : public simlib3::Event
+    /**
+     * @brief Blocks a facility for given time (e.g. conveyor breakdown)
+     *
+     * Totes already inside finish their pass, others wait in front of the facility until it is repaired.
+     */
+    class FailureProcess_t : public simlib3::Process
     {
         public:
-            OrderRequest_t(WarehouseSimulatorSIMLIB_t&);
+            FailureProcess_t(int32_t, double, WarehouseSimulatorSIMLIB_t&);
 
         protected:
             void Behavior() override;
 
         private:
+            int32_t whItemID;
+            double duration;
             WarehouseSimulatorSIMLIB_t& sim;
-            std::vector<WarehouseOrder_t>::const_iterator it;
     };
 }
 
@@ -0,0 +1,221 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseSimulatorTelemetry.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Opt-in per-facility queueing telemetry sampled during simulation (queue length, wait time, utilisation)
+ */
+
+#ifdef WHM_SIM
+
+// Std
+#include <fstream>
+#include <algorithm>
+
+// Local
+#include "Logger.h"
+#include "WarehouseSimulatorTelemetry.h"
+
+namespace whm
+{
+    WarehouseSimulatorTelemetry_t::WarehouseSimulatorTelemetry_t()
+    {
+
+    }
+
+    WarehouseSimulatorTelemetry_t::~WarehouseSimulatorTelemetry_t()
+    {
+
+    }
+
+    void WarehouseSimulatorTelemetry_t::init(const std::map<int32_t, simlib3::Store*>& whFacilities, size_t capacity_, double period_)
+    {
+        facilityIDs.clear();
+        facilities.clear();
+
+        for(const auto& whFacility : whFacilities)
+        {
+            facilityIDs.push_back(whFacility.first);
+            facilities.push_back(whFacility.second);
+        }
+
+        // Even capacity, so the buffer can be always halved during decimation
+        capacity = std::max<size_t>(2, capacity_ + capacity_ % 2);
+        initialPeriod = period_;
+
+        samples.assign(facilities.size() * capacity, Sample_t{});
+        sampleWaitCounts.assign(facilities.size() * capacity, 0);
+        prevWaitSum.assign(facilities.size(), 0.0);
+        prevBusyIntegral.assign(facilities.size(), 0.0);
+        prevWaitCount.assign(facilities.size(), 0);
+
+        reset();
+    }
+
+    void WarehouseSimulatorTelemetry_t::reset()
+    {
+        sampleCount = 0;
+        period = initialPeriod;
+        lastSampleTime = 0.0;
+
+        std::fill(prevWaitSum.begin(), prevWaitSum.end(), 0.0);
+        std::fill(prevBusyIntegral.begin(), prevBusyIntegral.end(), 0.0);
+        std::fill(prevWaitCount.begin(), prevWaitCount.end(), 0);
+    }
+
+    bool WarehouseSimulatorTelemetry_t::isEnabled() const
+    {
+        return capacity > 0;
+    }
+
+    double WarehouseSimulatorTelemetry_t::getPeriod() const
+    {
+        return period;
+    }
+
+    void WarehouseSimulatorTelemetry_t::sample(double time)
+    {
+        if(sampleCount == capacity)
+        {
+            decimate();
+        }
+
+        const double elapsed = time - lastSampleTime;
+
+        for(size_t f = 0; f < facilities.size(); ++f)
+        {
+            simlib3::Store* whFacility = facilities[f];
+            Sample_t& s = samples[f * capacity + sampleCount];
+
+            const double waitSum = whFacility->Q->StatDT.Sum();
+            const unsigned long waitCount = whFacility->Q->StatDT.Number();
+            const double busyIntegral = whFacility->tstat.MeanValue() * time;
+
+            s.time = static_cast<float>(time);
+            s.queueLength = static_cast<float>(whFacility->QueueLen());
+            s.waitTime = waitCount > prevWaitCount[f] ? static_cast<float>((waitSum - prevWaitSum[f]) / (waitCount - prevWaitCount[f])) : 0.f;
+            sampleWaitCounts[f * capacity + sampleCount] = static_cast<uint32_t>(waitCount - prevWaitCount[f]);
+            s.utilisation = elapsed > 0 ? static_cast<float>((busyIntegral - prevBusyIntegral[f]) / (elapsed * whFacility->Capacity())) : 0.f;
+
+            prevWaitSum[f] = waitSum;
+            prevWaitCount[f] = waitCount;
+            prevBusyIntegral[f] = busyIntegral;
+        }
+
+        lastSampleTime = time;
+        ++ sampleCount;
+    }
+
+    void WarehouseSimulatorTelemetry_t::decimate()
+    {
+        // Buffers are full, merge neighbouring samples and continue with twice the period,
+        // so the whole run stays covered without any allocation
+        for(size_t f = 0; f < facilities.size(); ++f)
+        {
+            Sample_t* buffer = &samples[f * capacity];
+            uint32_t* waitCounts = &sampleWaitCounts[f * capacity];
+
+            for(size_t i = 0; i < capacity / 2; ++i)
+            {
+                const Sample_t& lhs = buffer[2 * i];
+                const Sample_t& rhs = buffer[2 * i + 1];
+
+                const uint32_t lhsCount = waitCounts[2 * i];
+                const uint32_t rhsCount = waitCounts[2 * i + 1];
+
+                Sample_t merged;
+                merged.time = rhs.time;
+                merged.queueLength = (lhs.queueLength + rhs.queueLength) / 2.f;
+                merged.utilisation = (lhs.utilisation + rhs.utilisation) / 2.f;
+
+                // Wait time is mean over totes, period without any tote does not dilute it
+                merged.waitTime = lhsCount + rhsCount > 0 ? (lhs.waitTime * lhsCount + rhs.waitTime * rhsCount) / (lhsCount + rhsCount) : 0.f;
+
+                buffer[i] = merged;
+                waitCounts[i] = lhsCount + rhsCount;
+            }
+        }
+
+        sampleCount = capacity / 2;
+        period *= 2;
+    }
+
+    void WarehouseSimulatorTelemetry_t::exportCsv(const std::string& csvFilename) const
+    {
+        std::ofstream csvStream;
+        csvStream.open(csvFilename);
+
+        if(!csvStream)
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Failed to open telemetry file <%s>!", csvFilename.c_str());
+            return;
+        }
+
+        csvStream << "Warehouse item ID;Time;Queue length;Wait time;Utilisation\n";
+
+        for(size_t f = 0; f < facilities.size(); ++f)
+        {
+            for(size_t i = 0; i < sampleCount; ++i)
+            {
+                const Sample_t& s = samples[f * capacity + i];
+
+                csvStream << facilityIDs[f] << ";" << s.time << ";" << s.queueLength << ";"
+                          << s.waitTime << ";" << s.utilisation << "\n";
+            }
+        }
+
+        csvStream.close();
+    }
+
+    void WarehouseSimulatorTelemetry_t::exportBinary(const std::string& binFilename) const
+    {
+        std::ofstream binStream;
+        binStream.open(binFilename, std::ios::binary);
+
+        if(!binStream)
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Failed to open telemetry file <%s>!", binFilename.c_str());
+            return;
+        }
+
+        // Header: magic, version, facility count, samples per facility, sampling period
+        const char magic[4] = { 'W', 'H', 'M', 'T' };
+        const uint32_t version = 1;
+        const uint32_t facilityCount = static_cast<uint32_t>(facilities.size());
+        const uint32_t samplesPerFacility = static_cast<uint32_t>(sampleCount);
+
+        binStream.write(magic, sizeof(magic));
+        binStream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        binStream.write(reinterpret_cast<const char*>(&facilityCount), sizeof(facilityCount));
+        binStream.write(reinterpret_cast<const char*>(&samplesPerFacility), sizeof(samplesPerFacility));
+        binStream.write(reinterpret_cast<const char*>(&period), sizeof(period));
+
+        // Body: facility IDs followed by facility-major sample arrays
+        binStream.write(reinterpret_cast<const char*>(facilityIDs.data()), facilityIDs.size() * sizeof(int32_t));
+
+        for(size_t f = 0; f < facilities.size(); ++f)
+        {
+            binStream.write(reinterpret_cast<const char*>(&samples[f * capacity]), sampleCount * sizeof(Sample_t));
+        }
+
+        binStream.close();
+    }
+
+    // ================================================================================================================
+
+    TelemetrySampler_t::TelemetrySampler_t(WarehouseSimulatorTelemetry_t& telemetry_)
+        : telemetry(telemetry_)
+    {
+
+    }
+
+    void TelemetrySampler_t::Behavior()
+    {
+        telemetry.sample(Time);
+
+        Activate(Time + telemetry.getPeriod());
+    }
+}
+
+#endif
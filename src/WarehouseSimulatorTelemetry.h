@@ -0,0 +1,92 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseSimulatorTelemetry.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Opt-in per-facility queueing telemetry sampled during simulation (queue length, wait time, utilisation)
+ */
+
+#pragma once
+
+#ifdef WHM_SIM
+
+// Std
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// SIMLIB/C++
+#include <simlib.h>
+
+namespace whm
+{
+    class WarehouseSimulatorTelemetry_t
+    {
+        public:
+            /**
+             * @brief One sample of a facility, values are averaged over the sampling period
+             */
+            struct Sample_t
+            {
+                float time{ 0.f };         //< Simulation time at the end of the period [s]
+                float queueLength{ 0.f };  //< Number of totes waiting to enter the facility
+                float waitTime{ 0.f };     //< Mean time spent in queue by totes which entered during the period [s]
+                float utilisation{ 0.f };  //< Mean used capacity / total capacity during the period [-]
+            };
+
+            WarehouseSimulatorTelemetry_t();
+            ~WarehouseSimulatorTelemetry_t();
+
+            void init(const std::map<int32_t, simlib3::Store*>&, size_t, double);
+            void reset();
+
+            void sample(double);
+
+            bool isEnabled() const;
+            double getPeriod() const;
+
+            void exportCsv(const std::string&) const;
+            void exportBinary(const std::string&) const;
+
+        protected:
+            void decimate();
+
+        private:
+            // Facilities in the same order as their sample buffers
+            std::vector<int32_t> facilityIDs;
+            std::vector<simlib3::Store*> facilities;
+
+            // Running statistics at the previous sample, used to obtain per-period values
+            std::vector<double> prevWaitSum;
+            std::vector<double> prevBusyIntegral;
+            std::vector<unsigned long> prevWaitCount;
+
+            // Facility-major sample buffers, capacity samples per facility, allocated once in init
+            std::vector<Sample_t> samples;
+            std::vector<uint32_t> sampleWaitCounts;   //< Totes behind wait time of each sample, weigh merged wait times
+
+            size_t capacity{ 0 };
+            size_t sampleCount{ 0 };
+
+            double period{ 0.0 };
+            double initialPeriod{ 0.0 };
+            double lastSampleTime{ 0.0 };
+    };
+
+
+    class TelemetrySampler_t : public simlib3::Event
+    {
+        public:
+            TelemetrySampler_t(WarehouseSimulatorTelemetry_t&);
+
+        protected:
+            void Behavior() override;
+
+        private:
+            WarehouseSimulatorTelemetry_t& telemetry;
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseThreadPool.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Fixed set of worker threads running parallel loops
+ */
+
+// Local
+#include "WarehouseThreadPool.h"
+
+namespace whm
+{
+    WarehouseThreadPool_t::WarehouseThreadPool_t(size_t threadCount)
+        : owner{ getpid() }
+        , workers{ new std::vector<std::thread>() }
+    {
+        // Caller is one of the threads
+        for(size_t i = 1; i < threadCount; ++i)
+        {
+            workers->emplace_back(&WarehouseThreadPool_t::work, this);
+        }
+    }
+
+    WarehouseThreadPool_t::~WarehouseThreadPool_t()
+    {
+        if(getpid() != owner)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        wakeup.notify_all();
+
+        for(auto& worker : *workers)
+        {
+            worker.join();
+        }
+
+        delete workers;
+    }
+
+    void WarehouseThreadPool_t::parallelFor(size_t count, const Task_t& task_)
+    {
+        if(workers->empty() || count < 2 || getpid() != owner)
+        {
+            for(size_t i = 0; i < count; ++i)
+            {
+                task_(i);
+            }
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            task = &task_;
+            taskCount = count;
+            nextTask.store(0, std::memory_order_relaxed);
+            activeWorkers = workers->size();
+            ++generation;
+        }
+
+        wakeup.notify_all();
+
+        runTasks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return activeWorkers == 0; });
+
+        task = nullptr;
+    }
+
+    size_t WarehouseThreadPool_t::getThreadCount() const
+    {
+        return workers->size() + 1;
+    }
+
+    void WarehouseThreadPool_t::work()
+    {
+        uint64_t seen{ 0 };
+
+        for(;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeup.wait(lock, [this, seen]() { return stopping || generation != seen; });
+
+                if(stopping)
+                {
+                    return;
+                }
+
+                seen = generation;
+            }
+
+            runTasks();
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if(--activeWorkers == 0)
+            {
+                finished.notify_one();
+            }
+        }
+    }
+
+    void WarehouseThreadPool_t::runTasks()
+    {
+        for(size_t i = nextTask.fetch_add(1, std::memory_order_relaxed); i < taskCount; i = nextTask.fetch_add(1, std::memory_order_relaxed))
+        {
+            (*task)(i);
+        }
+    }
+}
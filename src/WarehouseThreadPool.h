@@ -0,0 +1,66 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseThreadPool.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Fixed set of worker threads running parallel loops
+ */
+
+#pragma once
+
+// Std
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+// Unix
+#include <unistd.h>
+
+namespace whm
+{
+    /**
+     * @brief Workers wait for a loop, caller takes part in it and returns when all iterations are done
+     *
+     * Threads do not survive fork, so a pool inherited by a child process runs loops serially.
+     */
+    class WarehouseThreadPool_t
+    {
+        public:
+            using Task_t = std::function<void(size_t)>;
+
+            explicit WarehouseThreadPool_t(size_t);
+            ~WarehouseThreadPool_t();
+
+            WarehouseThreadPool_t(const WarehouseThreadPool_t&) = delete;
+            WarehouseThreadPool_t& operator=(const WarehouseThreadPool_t&) = delete;
+
+            /// Calls task(i) for i in [0, count)
+            void parallelFor(size_t, const Task_t&);
+
+            size_t getThreadCount() const;
+
+        protected:
+            void work();
+            void runTasks();
+
+        private:
+            pid_t owner;                         //< Process which started the workers
+            std::vector<std::thread>* workers;   //< Leaked in a forked child, threads can't be joined there
+
+            std::mutex mutex;
+            std::condition_variable wakeup;
+            std::condition_variable finished;
+
+            const Task_t* task{ nullptr };
+            size_t taskCount{ 0 };
+            std::atomic<size_t> nextTask{ 0 };
+            size_t activeWorkers{ 0 };
+            uint64_t generation{ 0 };
+            bool stopping{ false };
+    };
+}
@@ -0,0 +1,289 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseTourCache.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Best tours of already solved location sets
+ */
+
+// Std
+#include <cstdio>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <exception>
+
+// Local
+#include "Logger.h"
+#include "WarehouseTourCache.h"
+
+namespace whm
+{
+    namespace
+    {
+        /// SplitMix64 finalizer
+        uint64_t mix(uint64_t z)
+        {
+            z += 0x9e3779b97f4a7c15ULL;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+            return z ^ (z >> 31);
+        }
+
+        std::vector<int32_t> readIDs(const std::string& field)
+        {
+            std::vector<int32_t> ids;
+            std::istringstream stream(field);
+
+            for(int32_t id; stream >> id;)
+            {
+                ids.push_back(id);
+            }
+
+            return ids;
+        }
+
+        void writeIDs(std::ostream& os, const std::vector<int32_t>& ids)
+        {
+            for(size_t i = 0; i < ids.size(); ++i)
+            {
+                os << (i ? " " : "") << ids[i];
+            }
+        }
+    }
+
+    WarehouseTourCache_t::WarehouseTourCache_t(size_t capacity_, const std::string& filename_)
+        : filename{ filename_ }
+        , capacity{ capacity_ }
+        , owner{ getpid() }
+    {
+        if(!filename.empty())
+        {
+            try
+            {
+                load();
+            }
+            catch(const std::exception& e)
+            {
+                Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_WARNING, "Tour cache <%s> is corrupted, ignoring it (%s)", filename.c_str(), e.what());
+
+                tours.clear();
+                recentUse.clear();
+                pathsFingerprint = 0;
+            }
+        }
+    }
+
+    WarehouseTourCache_t::~WarehouseTourCache_t()
+    {
+        if(dirty && getpid() == owner)
+        {
+            save();
+        }
+    }
+
+    WarehouseTourCache_t::Key_t WarehouseTourCache_t::makeKey(int32_t start, int32_t finish, std::vector<int32_t> locations)
+    {
+        std::sort(locations.begin(), locations.end());
+
+        locations.insert(locations.begin(), { start, finish });
+
+        return locations;
+    }
+
+    size_t WarehouseTourCache_t::KeyHash_t::operator()(const Key_t& key) const
+    {
+        uint64_t hash = key.size();
+
+        for(int32_t id : key)
+        {
+            hash = mix(hash ^ static_cast<uint32_t>(id));
+        }
+
+        return static_cast<size_t>(hash);
+    }
+
+    void WarehouseTourCache_t::validate(uint64_t pathsFingerprint_)
+    {
+        if(pathsFingerprint_ == pathsFingerprint)
+        {
+            return;
+        }
+
+        if(!tours.empty())
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "Path table changed, dropping <%zu> cached tours", tours.size());
+
+            tours.clear();
+            recentUse.clear();
+            dirty = true;
+        }
+
+        pathsFingerprint = pathsFingerprint_;
+    }
+
+    void WarehouseTourCache_t::evict()
+    {
+        while(capacity > 0 && tours.size() > capacity)
+        {
+            tours.erase(tours.find(*recentUse.back()));
+            recentUse.pop_back();
+        }
+    }
+
+    bool WarehouseTourCache_t::find(uint64_t pathsFingerprint_, const Key_t& key, Tour_t& tour)
+    {
+        // Exclusive, hit moves the tour to the front of recently used ones
+        std::unique_lock<std::shared_mutex> lock(mutex);
+
+        validate(pathsFingerprint_);
+
+        auto it = tours.find(key);
+
+        if(it == tours.end())
+        {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        recentUse.splice(recentUse.begin(), recentUse, it->second.use);
+
+        hits.fetch_add(1, std::memory_order_relaxed);
+        tour = it->second.tour;
+
+        return true;
+    }
+
+    void WarehouseTourCache_t::insert(uint64_t pathsFingerprint_, const Key_t& key, const Tour_t& tour)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+
+        validate(pathsFingerprint_);
+
+        auto [it, inserted] = tours.try_emplace(key);
+
+        if(inserted)
+        {
+            recentUse.push_front(&it->first);
+            it->second.use = recentUse.begin();
+        }
+        else
+        {
+            recentUse.splice(recentUse.begin(), recentUse, it->second.use);
+        }
+
+        if(inserted || tour.cost < it->second.tour.cost)
+        {
+            it->second.tour = tour;
+            dirty = true;
+        }
+
+        evict();
+    }
+
+    size_t WarehouseTourCache_t::size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+
+        return tours.size();
+    }
+
+    size_t WarehouseTourCache_t::getHits() const
+    {
+        return hits.load(std::memory_order_relaxed);
+    }
+
+    size_t WarehouseTourCache_t::getMisses() const
+    {
+        return misses.load(std::memory_order_relaxed);
+    }
+
+    void WarehouseTourCache_t::load()
+    {
+        std::ifstream stream(filename, std::ios::binary);
+
+        if(!stream)
+        {
+            // Not created yet
+            return;
+        }
+
+        std::string line;
+
+        // Fingerprint first, then one tour per line: cost;key;tour, most recently used first
+        if(!std::getline(stream, line) || line.empty())
+        {
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_WARNING, "Tour cache <%s> is empty, ignoring it", filename.c_str());
+            return;
+        }
+
+        pathsFingerprint = std::stoull(line);
+
+        while((capacity == 0 || tours.size() < capacity) && std::getline(stream, line))
+        {
+            if(!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+
+            size_t first = line.find(';');
+            size_t second = line.find(';', first + 1);
+
+            if(first == std::string::npos || second == std::string::npos)
+            {
+                continue;
+            }
+
+            Tour_t tour;
+            tour.cost = std::stoi(line.substr(0, first));
+            tour.whItemIDs = readIDs(line.substr(second + 1));
+
+            auto [it, inserted] = tours.try_emplace(readIDs(line.substr(first + 1, second - first - 1)));
+
+            if(inserted)
+            {
+                it->second.tour = std::move(tour);
+                it->second.use = recentUse.insert(recentUse.end(), &it->first);
+            }
+        }
+
+        Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_DEBUG, "Loaded <%zu> cached tours from <%s>", tours.size(), filename.c_str());
+    }
+
+    void WarehouseTourCache_t::save() const
+    {
+        if(filename.empty())
+        {
+            return;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(mutex);
+
+        // Written aside and renamed, so the file is never left half written
+        std::string tmpFilename = filename + ".tmp";
+        std::ofstream stream(tmpFilename, std::ios::binary | std::ios::trunc);
+
+        stream << pathsFingerprint << '\n';
+
+        for(const Key_t* key : recentUse)
+        {
+            const Tour_t& tour = tours.find(*key)->second.tour;
+
+            stream << tour.cost << ';';
+            writeIDs(stream, *key);
+            stream << ';';
+            writeIDs(stream, tour.whItemIDs);
+            stream << '\n';
+        }
+
+        stream.close();
+
+        if(!stream || std::rename(tmpFilename.c_str(), filename.c_str()))
+        {
+            std::remove(tmpFilename.c_str());
+            Logger_t::getLogger().print(LOG_LOC, LogLevel_t::E_ERROR, "Failed to save tour cache <%s>", filename.c_str());
+        }
+    }
+}
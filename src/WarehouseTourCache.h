@@ -0,0 +1,98 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseTourCache.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Best tours of already solved location sets
+ */
+
+#pragma once
+
+// Std
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+
+// Unix
+#include <unistd.h>
+
+namespace whm
+{
+    /**
+     * @brief Tours keyed by start, finish and sorted set of locations (warehouse item IDs)
+     *
+     * Tours stay valid as long as the table of shortest paths they were computed on. Lookups pass
+     * fingerprint of the caller's table (WarehousePathFinder_t::getPathsFingerprint) and the cache
+     * drops all tours once it changes. At most given number of tours is kept, the least recently
+     * used ones are evicted. Optional file is loaded on construction and rewritten on destruction
+     * when new tours were added.
+     */
+    class WarehouseTourCache_t
+    {
+        public:
+            using Key_t = std::vector<int32_t>;
+
+            struct Tour_t
+            {
+                int32_t cost{ 0 };
+                std::vector<int32_t> whItemIDs;  //< Visited items including start and finish
+            };
+
+            explicit WarehouseTourCache_t(size_t = 0, const std::string& = std::string());
+            ~WarehouseTourCache_t();
+
+            WarehouseTourCache_t(const WarehouseTourCache_t&) = delete;
+            WarehouseTourCache_t& operator=(const WarehouseTourCache_t&) = delete;
+
+            /// Canonical key, order of the locations does not matter
+            static Key_t makeKey(int32_t, int32_t, std::vector<int32_t>);
+
+            // Path table fingerprint first, tours of a different table are dropped
+            bool find(uint64_t, const Key_t&, Tour_t&);
+            void insert(uint64_t, const Key_t&, const Tour_t&);
+
+            void save() const;
+
+            size_t size() const;
+            size_t getHits() const;
+            size_t getMisses() const;
+
+        protected:
+            void load();
+
+            // Mutex is held by the caller
+            void validate(uint64_t);
+            void evict();
+
+        private:
+            struct KeyHash_t
+            {
+                size_t operator()(const Key_t&) const;
+            };
+
+            struct Entry_t
+            {
+                Tour_t tour;
+                std::list<const Key_t*>::iterator use;  //< Position in recentUse
+            };
+
+            std::string filename;
+            size_t capacity{ 0 };             //< 0 = unlimited
+            pid_t owner;                      //< Forked children do not write the file
+            uint64_t pathsFingerprint{ 0 };
+            bool dirty{ false };
+
+            mutable std::shared_mutex mutex;
+            std::unordered_map<Key_t, Entry_t, KeyHash_t> tours;
+            std::list<const Key_t*> recentUse;    //< Keys of tours, most recently used first
+
+            mutable std::atomic<size_t> hits{ 0 };
+            mutable std::atomic<size_t> misses{ 0 };
+    };
+}
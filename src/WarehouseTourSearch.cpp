@@ -0,0 +1,132 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseTourSearch.cpp
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Construction and local search of tours with fixed start and finish
+ */
+
+// Std
+#include <algorithm>
+
+// Local
+#include "WarehouseTourSearch.h"
+
+namespace whm
+{
+    namespace tour
+    {
+        int32_t length(const WarehouseMatrix_t<int32_t>& distances, const std::vector<int32_t>& tour)
+        {
+            int32_t d{ 0 };
+
+            for(size_t i = 1; i < tour.size(); ++i)
+            {
+                d += distances(tour[i - 1], tour[i]);
+            }
+
+            return d;
+        }
+
+        std::vector<int32_t> nearestNeighbour(const WarehouseMatrix_t<int32_t>& distances, int32_t start, int32_t finish, const std::vector<int32_t>& nodes)
+        {
+            std::vector<int32_t> tour{ start };
+            std::vector<int32_t> open{ nodes };
+
+            tour.reserve(nodes.size() + 2);
+
+            while(!open.empty())
+            {
+                size_t nearest{ 0 };
+
+                for(size_t i = 1; i < open.size(); ++i)
+                {
+                    if(distances(tour.back(), open[i]) < distances(tour.back(), open[nearest]))
+                    {
+                        nearest = i;
+                    }
+                }
+
+                tour.push_back(open[nearest]);
+
+                open[nearest] = open.back();
+                open.pop_back();
+            }
+
+            tour.push_back(finish);
+
+            return tour;
+        }
+
+        bool improveTwoOpt(const WarehouseMatrix_t<int32_t>& distances, std::vector<int32_t>& tour)
+        {
+            // Segment tour[i..k] is reversed, its inner edges change direction
+            for(size_t i = 1; i + 2 < tour.size(); ++i)
+            {
+                int32_t forward{ 0 };
+                int32_t backward{ 0 };
+
+                for(size_t k = i + 1; k + 1 < tour.size(); ++k)
+                {
+                    forward  += distances(tour[k - 1], tour[k]);
+                    backward += distances(tour[k], tour[k - 1]);
+
+                    int32_t delta = distances(tour[i - 1], tour[k]) + backward + distances(tour[i], tour[k + 1])
+                                  - distances(tour[i - 1], tour[i]) - forward - distances(tour[k], tour[k + 1]);
+
+                    if(delta < 0)
+                    {
+                        std::reverse(tour.begin() + i, tour.begin() + k + 1);
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        bool improveOrOpt(const WarehouseMatrix_t<int32_t>& distances, std::vector<int32_t>& tour)
+        {
+            // Segment keeps its direction
+            for(size_t length = 1; length <= 3; ++length)
+            {
+                for(size_t i = 1; i + length < tour.size(); ++i)
+                {
+                    int32_t first = tour[i];
+                    int32_t last  = tour[i + length - 1];
+                    int32_t prev  = tour[i - 1];
+                    int32_t next  = tour[i + length];
+
+                    int32_t removeGain = distances(prev, first) + distances(last, next) - distances(prev, next);
+
+                    for(size_t j = 0; j + 1 < tour.size(); ++j)
+                    {
+                        if(j + 1 >= i && j <= i + length - 1)
+                        {
+                            continue;
+                        }
+
+                        int32_t delta = distances(tour[j], first) + distances(last, tour[j + 1]) - distances(tour[j], tour[j + 1]) - removeGain;
+
+                        if(delta < 0)
+                        {
+                            std::vector<int32_t> segment(tour.begin() + i, tour.begin() + i + length);
+
+                            tour.erase(tour.begin() + i, tour.begin() + i + length);
+                            tour.insert(tour.begin() + (j < i ? j + 1 : j + 1 - length), segment.begin(), segment.end());
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
+        void improve(const WarehouseMatrix_t<int32_t>& distances, std::vector<int32_t>& tour)
+        {
+            while(improveTwoOpt(distances, tour) || improveOrOpt(distances, tour));
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/**
+ * Warehouse manager
+ *
+ * @file    WarehouseTourSearch.h
+ * @date    10/19/2026
+ * @author  Filip Kocica
+ * @brief   Construction and local search of tours with fixed start and finish
+ */
+
+#pragma once
+
+// Std
+#include <vector>
+#include <cstdint>
+
+// Local
+#include "WarehouseMatrix.h"
+
+namespace whm
+{
+    /**
+     * @brief Tours are indices into distance matrix, first and last element stay in place
+     *
+     * Distances may be asymmetric (one-way conveyors), all moves are evaluated in the direction
+     * the tour is travelled.
+     */
+    namespace tour
+    {
+        int32_t length(const WarehouseMatrix_t<int32_t>&, const std::vector<int32_t>&);
+
+        /// Start, nearest not yet visited node until all are visited, finish
+        std::vector<int32_t> nearestNeighbour(const WarehouseMatrix_t<int32_t>&, int32_t, int32_t, const std::vector<int32_t>&);
+
+        /// Reverses segment of the tour, returns after the first improving move
+        bool improveTwoOpt(const WarehouseMatrix_t<int32_t>&, std::vector<int32_t>&);
+
+        /// Moves segment of up to three nodes elsewhere, returns after the first improving move
+        bool improveOrOpt(const WarehouseMatrix_t<int32_t>&, std::vector<int32_t>&);
+
+        /// Both neighbourhoods until local optimum
+        void improve(const WarehouseMatrix_t<int32_t>&, std::vector<int32_t>&);
+    }
+}
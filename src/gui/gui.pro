@@ -17,9 +17,17 @@ SOURCES +=  ../main.cpp \
             ../WarehousePort.cpp \
             ../WarehouseOrder.cpp \
             ../WarehouseLayout.cpp \
+            ../WarehouseLayoutGraph.cpp \
+            ../WarehouseThreadPool.cpp \
+            ../WarehouseTourCache.cpp \
+            ../WarehouseTourSearch.cpp \
+            ../WarehouseOrderBatcher.cpp \
             ../WarehouseOrderLine.cpp \
+            ../WarehouseOrderBook.cpp \
+            ../WarehouseOrderParser.cpp \
             ../WarehouseConnection.cpp \
             ../WarehousePathFinder.cpp \
+            ../WarehouseArticles.cpp \
             ../WarehouseLocationSlot.cpp \
             ../WarehouseLocationRack.cpp \
             ../WarehouseOptimizerBase.cpp \
@@ -31,6 +39,7 @@ SOURCES +=  ../main.cpp \
             ../WarehouseOptimizerRAND.cpp \
             ../WarehousePathFinderACO.cpp \
             ../WarehouseSimulatorSIMLIB.cpp \
+            ../WarehouseSimulatorTelemetry.cpp \
             ../WarehouseDataGenerator.cpp \
             UiCursor.cpp \
             MainWindow.cpp \
@@ -59,9 +68,18 @@ HEADERS +=  ../Utils.h \
             ../WarehousePort.h \
             ../WarehouseOrder.h \
             ../WarehouseLayout.h \
+            ../WarehouseLayoutGraph.h \
+            ../WarehouseMatrix.h \
+            ../WarehouseThreadPool.h \
+            ../WarehouseTourCache.h \
+            ../WarehouseTourSearch.h \
+            ../WarehouseOrderBatcher.h \
             ../WarehouseOrderLine.h \
+            ../WarehouseOrderBook.h \
+            ../WarehouseOrderParser.h \
             ../WarehouseConnection.h \
             ../WarehousePathFinder.h \
+            ../WarehouseArticles.h \
             ../WarehouseLocationSlot.h \
             ../WarehouseLocationRack.h \
             ../WarehouseOptimizerBase.h \
@@ -73,6 +91,8 @@ HEADERS +=  ../Utils.h \
             ../WarehouseOptimizerRAND.h \
             ../WarehousePathFinderACO.h \
             ../WarehouseSimulatorSIMLIB.h \
+            ../WarehouseSimulatorTelemetry.h \
+            ../ObjectPool.h \
             ../WarehouseDataGenerator.h \
             MainWindow.h \
             UiCursor.h \
@@ -1316,8 +1316,7 @@ namespace whm
             whm::WarehouseLayout_t::getWhLayout().clearWhLayout();
             whm::WarehouseLayout_t::getWhLayout().initFromGui(UiWarehouseLayout_t::getWhLayout());
 
-            pathFinder.clearPrecalculatedPaths();
-            pathFinder.precalculatePaths(whm::WarehouseLayout_t::getWhLayout().getWhItems());
+            pathFinder.sharePaths(whm::WarehouseLayout_t::getWhLayout().getWhPathFinder());
 
             whm::ConfigParser_t cfg;
             exportPathfinderConfig(cfg);
@@ -36,6 +36,10 @@
 #  include "WarehousePathFinderACO.h"
 #endif
 
+#ifdef WHM_BENCH
+#  include "WarehouseBenchmark.h"
+#endif
+
 // Qt
 #ifdef WHM_GUI
 #  include <QApplication>
@@ -58,8 +62,18 @@ int main(int argc, char *argv[])
 #else
         const auto& args = whm::utils::parseArgs(argc, argv);
 
+        if(!args.convertPath.empty())
+        {
+            whm::WarehouseLayout_t::getWhLayout().importCustomerOrders(args.ordersPath);
+            whm::WarehouseLayout_t::getWhLayout().exportCustomerOrdersBinary(args.convertPath);
+
+            return 0;
+        }
+
 #  ifdef WHM_GEN
             whm::WarehouseDataGenerator_t{args}.generateData();
+#  elif defined(WHM_BENCH)
+            whm::WarehouseBenchmark_t{args}.run();
 #  else
             whm::WarehouseLayout_t::getWhLayout().deserializeFromXml(args.layoutPath);
             whm::WarehouseLayout_t::getWhLayout().importLocationSlots(args.locationsPath);
@@ -100,7 +114,15 @@ int main(int argc, char *argv[])
 #    ifdef WHM_SIM
             whm::WarehouseSimulatorSIMLIB_t simulator;
             simulator.setArguments(args);
-            simulator.runSimulation();
+
+            if(simulator.getConfig().isSet("replications") && simulator.getConfig().getAs<int32_t>("replications") > 1)
+            {
+                simulator.runReplications();
+            }
+            else
+            {
+                simulator.runSimulation();
+            }
 #    endif
 #  endif
 #endif
@@ -113,6 +135,8 @@ int main(int argc, char *argv[])
     }
     catch(std::exception& e)
     {
+        whm::Logger_t::getLogger().flush();
+
         std::cerr << "Unexpected problem has occured ("
                   << e.what() << ")" << std::endl;
     }